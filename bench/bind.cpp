@@ -0,0 +1,84 @@
+#include "common.hpp"
+
+#include "loltoml/bind.hpp"
+#include "loltoml/document.hpp"
+
+
+namespace {
+    struct backend_t {
+        std::string host;
+        std::int64_t port;
+        double weight;
+        bool enabled;
+    };
+
+    LOLTOML_BIND(backend_t, host, port, weight, enabled);
+
+    struct service_t {
+        std::string name;
+        std::int64_t workers;
+        double timeout;
+        std::vector<std::string> tags;
+        std::vector<backend_t> backends;
+    };
+
+    LOLTOML_BIND(service_t, name, workers, timeout, tags, backends);
+
+    // A service config reloaded over and over.
+    std::string generate_config() {
+        std::string config = "name = \"gateway\"\nworkers = 16\ntimeout = 2.5\ntags = [\"edge\", \"public\", \"v2\"]\n";
+
+        for (int i = 0; i < 200; ++i) {
+            config += "[[backends]]\nhost = \"backend-" + std::to_string(i) + ".internal\"\nport = " + std::to_string(8000 + i) +
+                      "\nweight = 0.5\nenabled = true\n";
+        }
+
+        return config;
+    }
+
+    void BM_BindConfig(benchmark::State &state) {
+        std::string config = generate_config();
+
+        for (auto _ : state) {
+            service_t service = loltoml::parse_into<service_t>(config.data(), config.data() + config.size());
+            benchmark::DoNotOptimize(service.backends.data());
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * config.size()));
+    }
+
+    // The same struct filled from a DOM by looking the keys up.
+    void BM_DocumentConfig(benchmark::State &state) {
+        std::string config = generate_config();
+
+        for (auto _ : state) {
+            loltoml::document_t document = loltoml::parse_document(config.data(), config.data() + config.size());
+            service_t service = service_t();
+
+            service.name = document.find("name")->as_string().str();
+            service.workers = document.find("workers")->as_integer();
+            service.timeout = document.find("timeout")->as_floating_point();
+
+            for (const loltoml::member_t &tag: *document.find("tags")) {
+                service.tags.push_back(tag.value.as_string().str());
+            }
+
+            for (const loltoml::member_t &item: *document.find("backends")) {
+                backend_t backend;
+                backend.host = item.value.find("host")->as_string().str();
+                backend.port = item.value.find("port")->as_integer();
+                backend.weight = item.value.find("weight")->as_floating_point();
+                backend.enabled = item.value.find("enabled")->as_boolean();
+                service.backends.push_back(backend);
+            }
+
+            benchmark::DoNotOptimize(service.backends.data());
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * config.size()));
+    }
+}
+
+
+BENCHMARK(BM_BindConfig);
+BENCHMARK(BM_DocumentConfig);
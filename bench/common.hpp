@@ -0,0 +1,54 @@
+#include "loltoml/parse.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+
+// Accepts all events and only counts them, so that (almost) only the parser itself is measured.
+struct null_handler_t {
+    null_handler_t() :
+        events(0)
+    { }
+
+    void start_document() { ++events; }
+    void finish_document() { ++events; }
+    void comment(const std::string &) { ++events; }
+    void array_table(loltoml::key_iterator_t, loltoml::key_iterator_t) { ++events; }
+    void table(loltoml::key_iterator_t, loltoml::key_iterator_t) { ++events; }
+    void key(const std::string &) { ++events; }
+    void start_array() { ++events; }
+    void finish_array(std::size_t) { ++events; }
+    void start_inline_table() { ++events; }
+    void finish_inline_table(std::size_t) { ++events; }
+    void boolean(bool) { ++events; }
+    void string(const std::string &) { ++events; }
+    void datetime(const std::string &) { ++events; }
+    void integer(std::int64_t) { ++events; }
+    void floating_point(double) { ++events; }
+    void symbol(const std::string &) { ++events; }
+
+    std::size_t events;
+};
+
+// Reports parsing speed both in bytes (MB/s) and in SAX-events per second.
+inline void report_speed(benchmark::State &state, std::size_t document_size, std::size_t events) {
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document_size));
+    state.counters["events"] = benchmark::Counter(static_cast<double>(events), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+inline void parse_document(benchmark::State &state,
+                           const std::string &document,
+                           const loltoml::parse_options_t &options = loltoml::parse_options_t())
+{
+    std::size_t events = 0;
+
+    for (auto _ : state) {
+        null_handler_t handler;
+        loltoml::parse(document.data(), document.data() + document.size(), handler, options);
+        events = handler.events;
+    }
+
+    report_speed(state, document.size(), events);
+}
@@ -0,0 +1,76 @@
+#include "common.hpp"
+#include "corpus.hpp"
+
+#include "loltoml/parse_file.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+
+namespace {
+    void BM_Corpus(benchmark::State &state, corpus_kind_t kind) {
+        parse_document(state, generate_corpus(kind, static_cast<std::size_t>(state.range(0))));
+    }
+
+    void BM_File(benchmark::State &state, const std::string &path) {
+        std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+        std::size_t size = static_cast<std::size_t>(file.tellg());
+        std::size_t events = 0;
+
+        for (auto _ : state) {
+            null_handler_t handler;
+            loltoml::parse_file(path.c_str(), handler);
+            events = handler.events;
+        }
+
+        report_speed(state, size, events);
+    }
+
+    /*
+     * Documents too large to be generated on each run (up to gigabytes) are created once with loltoml-corpus
+     * and passed in the LOLTOML_BENCH_FILES environment variable as a colon-separated list of paths.
+     */
+    struct file_benchmarks_t {
+        file_benchmarks_t() {
+            const char *files = std::getenv("LOLTOML_BENCH_FILES");
+
+            if (!files) {
+                return;
+            }
+
+            std::string paths(files);
+            std::string::size_type begin = 0;
+
+            while (begin < paths.size()) {
+                std::string::size_type end = paths.find(':', begin);
+
+                if (end == std::string::npos) {
+                    end = paths.size();
+                }
+
+                if (end > begin) {
+                    std::string path = paths.substr(begin, end - begin);
+                    benchmark::RegisterBenchmark(("BM_File/" + path).c_str(), BM_File, path)->Unit(benchmark::kMillisecond);
+                }
+
+                begin = end + 1;
+            }
+        }
+    } file_benchmarks;
+}
+
+
+// Every token class on a small (1 KB) and a large (1 MB) document.
+BENCHMARK_CAPTURE(BM_Corpus, integers, corpus_kind_t::integers)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Corpus, floats, corpus_kind_t::floats)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Corpus, basic_strings, corpus_kind_t::basic_strings)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Corpus, multiline_strings, corpus_kind_t::multiline_strings)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Corpus, literal_strings, corpus_kind_t::literal_strings)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Corpus, deep_tables, corpus_kind_t::deep_tables)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Corpus, array_tables, corpus_kind_t::array_tables)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Corpus, inline_tables, corpus_kind_t::inline_tables)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Corpus, comments, corpus_kind_t::comments)->Arg(1 << 10)->Arg(1 << 20);
+
+// Scaling of a realistic document with size.
+BENCHMARK_CAPTURE(BM_Corpus, mixed, corpus_kind_t::mixed)->RangeMultiplier(32)->Range(1 << 10, 1 << 25);
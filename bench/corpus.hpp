@@ -0,0 +1,171 @@
+#ifndef LOLTOML_BENCH_CORPUS_HPP
+#define LOLTOML_BENCH_CORPUS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+
+
+// Kinds of synthetic documents. Each one stresses a single token class, except mixed.
+enum class corpus_kind_t {
+    integers,
+    floats,
+    basic_strings,
+    multiline_strings,
+    literal_strings,
+    deep_tables,
+    array_tables,
+    inline_tables,
+    comments,
+    mixed
+};
+
+const corpus_kind_t corpus_kinds[] = {
+    corpus_kind_t::integers,
+    corpus_kind_t::floats,
+    corpus_kind_t::basic_strings,
+    corpus_kind_t::multiline_strings,
+    corpus_kind_t::literal_strings,
+    corpus_kind_t::deep_tables,
+    corpus_kind_t::array_tables,
+    corpus_kind_t::inline_tables,
+    corpus_kind_t::comments,
+    corpus_kind_t::mixed
+};
+
+inline const char *corpus_kind_name(corpus_kind_t kind) {
+    switch (kind) {
+        case corpus_kind_t::integers: return "integers";
+        case corpus_kind_t::floats: return "floats";
+        case corpus_kind_t::basic_strings: return "basic_strings";
+        case corpus_kind_t::multiline_strings: return "multiline_strings";
+        case corpus_kind_t::literal_strings: return "literal_strings";
+        case corpus_kind_t::deep_tables: return "deep_tables";
+        case corpus_kind_t::array_tables: return "array_tables";
+        case corpus_kind_t::inline_tables: return "inline_tables";
+        case corpus_kind_t::comments: return "comments";
+        case corpus_kind_t::mixed: return "mixed";
+    }
+
+    return "unknown";
+}
+
+// Returns false if there is no such kind.
+inline bool corpus_kind_from_name(const char *name, corpus_kind_t *kind) {
+    for (std::size_t i = 0; i < sizeof(corpus_kinds) / sizeof(corpus_kinds[0]); ++i) {
+        if (std::strcmp(name, corpus_kind_name(corpus_kinds[i])) == 0) {
+            *kind = corpus_kinds[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/*
+ * Produces a valid TOML document of the given kind record by record, so that documents of any size
+ * (from a kilobyte to gigabytes) can be generated without keeping them in memory.
+ * The output is deterministic.
+ */
+class corpus_generator_t {
+public:
+    explicit corpus_generator_t(corpus_kind_t kind) :
+        m_kind(kind),
+        m_random(42),
+        m_index(0)
+    { }
+
+    // Appends the next record (a few lines) to the document.
+    void append_record(std::string &document) {
+        corpus_kind_t kind = m_kind;
+
+        if (kind == corpus_kind_t::mixed) {
+            // Everything except mixed itself in turn.
+            kind = corpus_kinds[m_index % (sizeof(corpus_kinds) / sizeof(corpus_kinds[0]) - 1)];
+        }
+
+        std::string index = std::to_string(m_index++);
+
+        switch (kind) {
+            case corpus_kind_t::integers:
+                document += "int_" + index + " = " + integer() + "\n";
+                document += "ints_" + index + " = [" + integer() + ", " + integer() + ", " + integer() + "]\n";
+                break;
+            case corpus_kind_t::floats:
+                document += "float_" + index + " = " + floating_point() + "\n";
+                document += "floats_" + index + " = [" + floating_point() + ", " + floating_point() + "]\n";
+                break;
+            case corpus_kind_t::basic_strings:
+                document += "str_" + index + " = \"The quick brown fox " + index + " jumps over the lazy dog\"\n";
+                document += "escaped_" + index + " = \"tab\\there, quote \\\" and \\u00e9 in line " + index + "\"\n";
+                break;
+            case corpus_kind_t::multiline_strings:
+                document += "text_" + index + " = \"\"\"\nLorem ipsum dolor sit amet, \\\n"
+                            "    consectetur adipiscing elit, record " + index + ".\n"
+                            "Sed do eiusmod tempor incididunt.\"\"\"\n";
+                break;
+            case corpus_kind_t::literal_strings:
+                document += "path_" + index + " = 'C:\\Users\\loltoml\\file_" + index + ".toml'\n";
+                document += "regex_" + index + " = '''\n<\\i\\c*\\s*>[a-z]+" + index + "\n'''\n";
+                break;
+            case corpus_kind_t::deep_tables:
+                document += "[level_a.level_b.level_c.level_d.level_e.level_f.level_g.table_" + index + "]\n";
+                document += "value = " + index + "\n";
+                break;
+            case corpus_kind_t::array_tables:
+                document += "[[products]]\n";
+                document += "name = \"product " + index + "\"\n";
+                document += "sku = " + integer() + "\n";
+                document += "in_stock = true\n";
+                break;
+            case corpus_kind_t::inline_tables:
+                document += "point_" + index + " = { x = " + integer() + ", y = " + integer() +
+                            ", label = \"p" + index + "\", nested = { z = " + floating_point() + " } }\n";
+                break;
+            case corpus_kind_t::comments:
+                document += "# Setting number " + index + ". This comment was generated by a tool,\n";
+                document += "# and it explains the value below in a lot of detail.\n";
+                document += "setting_" + index + " = true    # trailing comment\n\n";
+                break;
+            case corpus_kind_t::mixed:
+                break;
+        }
+    }
+
+private:
+    std::string integer() {
+        return std::to_string(static_cast<std::int64_t>(m_random()) >> (m_random() % 63));
+    }
+
+    std::string floating_point() {
+        std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+        char value[32];
+        std::snprintf(value, sizeof(value), "%.6f", distribution(m_random));
+        return value;
+    }
+
+private:
+    corpus_kind_t m_kind;
+    std::mt19937_64 m_random;
+    std::size_t m_index;
+};
+
+
+// Generates a document of the given kind of at least the given size in bytes.
+inline std::string generate_corpus(corpus_kind_t kind, std::size_t size) {
+    corpus_generator_t generator(kind);
+    std::string document;
+    document.reserve(size + 256);
+
+    while (document.size() < size) {
+        generator.append_record(document);
+    }
+
+    return document;
+}
+
+#endif // LOLTOML_BENCH_CORPUS_HPP
@@ -0,0 +1,88 @@
+#include "corpus.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+
+namespace {
+    // Parses sizes like "1024", "64K", "10M", "1G".
+    bool parse_size(const char *text, std::size_t *size) {
+        char *suffix = nullptr;
+        unsigned long long value = std::strtoull(text, &suffix, 10);
+
+        if (suffix == text) {
+            return false;
+        }
+
+        switch (*suffix) {
+            case '\0': break;
+            case 'K': value <<= 10; break;
+            case 'M': value <<= 20; break;
+            case 'G': value <<= 30; break;
+            default: return false;
+        }
+
+        *size = static_cast<std::size_t>(value);
+        return true;
+    }
+
+    void print_usage(const char *program) {
+        std::cerr << "Usage: " << program << " <kind> <size> [output]" << std::endl
+                  << "Writes a synthetic TOML document of at least the given size (e.g. 1K, 64M, 1G)" << std::endl
+                  << "to the output file or to stdout. Kinds:";
+
+        for (std::size_t i = 0; i < sizeof(corpus_kinds) / sizeof(corpus_kinds[0]); ++i) {
+            std::cerr << " " << corpus_kind_name(corpus_kinds[i]);
+        }
+
+        std::cerr << std::endl;
+    }
+}
+
+
+int main(int argc, char *argv[]) {
+    corpus_kind_t kind;
+    std::size_t size;
+
+    if (argc < 3 || argc > 4 || !corpus_kind_from_name(argv[1], &kind) || !parse_size(argv[2], &size)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::ofstream file;
+
+    if (argc == 4) {
+        file.open(argv[3], std::ios::binary);
+
+        if (!file) {
+            std::cerr << "Cannot open " << argv[3] << std::endl;
+            return 1;
+        }
+    }
+
+    std::ostream &output = (argc == 4) ? file : std::cout;
+    corpus_generator_t generator(kind);
+    std::string chunk;
+    std::size_t written = 0;
+
+    while (written < size) {
+        generator.append_record(chunk);
+
+        if (chunk.size() >= (1 << 20) || written + chunk.size() >= size) {
+            output.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            written += chunk.size();
+            chunk.clear();
+        }
+    }
+
+    output.flush();
+
+    if (!output) {
+        std::cerr << "Write error" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "common.hpp"
+
+#include "loltoml/datetime.hpp"
+
+#include <cstdio>
+
+
+namespace {
+    // A time series: a timestamp on every line.
+    std::string generate_timestamps(std::size_t count) {
+        std::string document;
+        char line[64];
+
+        for (std::size_t i = 0; i < count; ++i) {
+            unsigned seconds = static_cast<unsigned>(i % 86400);
+            std::snprintf(line, sizeof(line), "t%u = 2024-03-%02uT%02u:%02u:%02u.%03uZ\n",
+                          static_cast<unsigned>(i % 1000), static_cast<unsigned>(1 + i % 28),
+                          seconds / 3600, seconds / 60 % 60, seconds % 60, static_cast<unsigned>(i % 1000));
+            document += line;
+        }
+
+        return document;
+    }
+
+    struct value_handler_t {
+        std::int64_t sum = 0;
+
+        void datetime(const loltoml::datetime_t &value) {
+            sum += value.epoch_seconds;
+        }
+    };
+
+    // What handlers had to do with datetimes passed as strings.
+    struct text_handler_t {
+        std::int64_t sum = 0;
+
+        void datetime(const std::string &value) {
+            unsigned year, month, day, hour, minute, second, millisecond;
+
+            if (std::sscanf(value.c_str(), "%4u-%2u-%2uT%2u:%2u:%2u.%3u",
+                            &year, &month, &day, &hour, &minute, &second, &millisecond) == 7) {
+                sum += day * 86400 + hour * 3600 + minute * 60 + second;
+            }
+        }
+    };
+
+    template<class Handler>
+    void BM_Timestamps(benchmark::State &state) {
+        std::string document = generate_timestamps(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state) {
+            Handler handler;
+            loltoml::parse(document.data(), document.data() + document.size(), handler);
+            benchmark::DoNotOptimize(handler.sum);
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * state.range(0)));
+    }
+}
+
+
+BENCHMARK_TEMPLATE(BM_Timestamps, value_handler_t)->Arg(50000);
+BENCHMARK_TEMPLATE(BM_Timestamps, text_handler_t)->Arg(50000);
@@ -0,0 +1,101 @@
+#include "common.hpp"
+#include "corpus.hpp"
+
+#include "loltoml/document.hpp"
+
+#include <memory>
+
+
+namespace {
+    // The usual DOM: every node, key and string is a separate heap allocation.
+    struct heap_node_t {
+        loltoml::value_type_t type;
+        std::string string;
+        std::int64_t integer;
+        double floating_point;
+        std::vector<std::pair<std::string, std::unique_ptr<heap_node_t>>> children;
+    };
+
+    // Builds heap_node_t trees. Table headers aren't merged, it's only the allocation pattern that matters here.
+    struct heap_builder_t {
+        typedef loltoml::string_ref_t string_type;
+
+        heap_node_t root;
+        std::vector<heap_node_t *> stack;
+        std::string current_key;
+
+        void start_document() {
+            stack.assign(1, &root);
+        }
+
+        void table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
+            heap_node_t *current = &root;
+
+            for (; begin != end; ++begin) {
+                current->children.emplace_back(*begin, std::unique_ptr<heap_node_t>(new heap_node_t()));
+                current = current->children.back().second.get();
+            }
+
+            stack.assign(1, current);
+        }
+
+        void array_table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
+            table(begin, end);
+        }
+
+        void key(loltoml::string_ref_t value) {
+            current_key.assign(value.data(), value.size());
+        }
+
+        heap_node_t *add(loltoml::value_type_t type) {
+            stack.back()->children.emplace_back(current_key, std::unique_ptr<heap_node_t>(new heap_node_t()));
+            heap_node_t *node = stack.back()->children.back().second.get();
+            node->type = type;
+            return node;
+        }
+
+        void start_array() { stack.push_back(add(loltoml::value_type_t::array)); }
+        void finish_array(std::size_t) { stack.pop_back(); }
+        void start_inline_table() { stack.push_back(add(loltoml::value_type_t::table)); }
+        void finish_inline_table(std::size_t) { stack.pop_back(); }
+        void boolean(bool value) { add(loltoml::value_type_t::boolean)->integer = value; }
+        void string(loltoml::string_ref_t value) { add(loltoml::value_type_t::string)->string = value.str(); }
+        void datetime(loltoml::string_ref_t value) { add(loltoml::value_type_t::datetime)->string = value.str(); }
+        void integer(std::int64_t value) { add(loltoml::value_type_t::integer)->integer = value; }
+        void floating_point(double value) { add(loltoml::value_type_t::floating_point)->floating_point = value; }
+        void symbol(loltoml::string_ref_t value) { add(loltoml::value_type_t::symbol)->string = value.str(); }
+    };
+
+    // Each iteration builds and drops the DOM of the document.
+    void BM_HeapDom(benchmark::State &state, corpus_kind_t kind) {
+        std::string document = generate_corpus(kind, static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state) {
+            heap_builder_t builder;
+            loltoml::parse(document.data(), document.data() + document.size(), builder);
+            benchmark::DoNotOptimize(builder.root.children.data());
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+    }
+
+    void BM_Document(benchmark::State &state, corpus_kind_t kind) {
+        std::string document = generate_corpus(kind, static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state) {
+            loltoml::document_t dom = loltoml::parse_document(document.data(), document.data() + document.size());
+            benchmark::DoNotOptimize(dom.root().size());
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+    }
+}
+
+
+// Small configs loaded and dropped over and over, and a large document.
+BENCHMARK_CAPTURE(BM_HeapDom, mixed, corpus_kind_t::mixed)->Arg(4 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Document, mixed, corpus_kind_t::mixed)->Arg(4 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_HeapDom, inline_tables, corpus_kind_t::inline_tables)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Document, inline_tables, corpus_kind_t::inline_tables)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_HeapDom, deep_tables, corpus_kind_t::deep_tables)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Document, deep_tables, corpus_kind_t::deep_tables)->Arg(1 << 20);
@@ -0,0 +1,93 @@
+#include "common.hpp"
+#include "corpus.hpp"
+
+#include <set>
+
+
+namespace {
+    // How the example decoders used to check keys: full paths in a std::set.
+    struct path_set_handler_t {
+        std::set<std::vector<std::string>> assigned_keys;
+        std::vector<std::string> path;
+        // Number of keys of path that belong to the table header.
+        std::size_t table_depth;
+        std::size_t nesting;
+        bool in_array_table;
+
+        path_set_handler_t() :
+            table_depth(0),
+            nesting(0),
+            in_array_table(false)
+        { }
+
+        void table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
+            path.assign(begin, end);
+            table_depth = path.size();
+            in_array_table = false;
+
+            if (!assigned_keys.insert(path).second) {
+                throw std::runtime_error("Duplicate table");
+            }
+        }
+
+        void array_table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
+            path.assign(begin, end);
+            table_depth = path.size();
+            in_array_table = true;
+            assigned_keys.insert(path);
+        }
+
+        void key(const std::string &key) {
+            path.resize(table_depth);
+            path.push_back(key);
+
+            // Keys of array tables, inline tables and arrays aren't checked, so it does less work than the checker.
+            if (nesting == 0 && !in_array_table && !assigned_keys.insert(path).second) {
+                throw std::runtime_error("Duplicate key");
+            }
+        }
+
+        void start_array() { ++nesting; }
+        void finish_array(std::size_t) { --nesting; }
+        void start_inline_table() { ++nesting; }
+        void finish_inline_table(std::size_t) { --nesting; }
+    };
+
+    // Keys are unique in all corpora except array tables, whose keys repeat in each element.
+    void BM_Keys(benchmark::State &state, corpus_kind_t kind, bool check) {
+        std::string document = generate_corpus(kind, static_cast<std::size_t>(state.range(0)));
+        loltoml::parse_options_t options;
+        options.check_duplicate_keys = check;
+
+        for (auto _ : state) {
+            null_handler_t handler;
+            loltoml::parse(document.data(), document.data() + document.size(), handler, options);
+            benchmark::DoNotOptimize(handler.events);
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+    }
+
+    void BM_KeysPathSet(benchmark::State &state, corpus_kind_t kind) {
+        std::string document = generate_corpus(kind, static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state) {
+            path_set_handler_t handler;
+            loltoml::parse(document.data(), document.data() + document.size(), handler);
+            benchmark::DoNotOptimize(handler.assigned_keys.size());
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+    }
+}
+
+
+BENCHMARK_CAPTURE(BM_Keys, deep_tables_unchecked, corpus_kind_t::deep_tables, false)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Keys, deep_tables_checked, corpus_kind_t::deep_tables, true)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_KeysPathSet, deep_tables, corpus_kind_t::deep_tables)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Keys, mixed_unchecked, corpus_kind_t::mixed, false)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Keys, mixed_checked, corpus_kind_t::mixed, true)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_KeysPathSet, mixed, corpus_kind_t::mixed)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Keys, array_tables_unchecked, corpus_kind_t::array_tables, false)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Keys, array_tables_checked, corpus_kind_t::array_tables, true)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_KeysPathSet, array_tables, corpus_kind_t::array_tables)->Arg(1 << 20);
@@ -0,0 +1,96 @@
+#include "common.hpp"
+
+#include "loltoml/key_interner.hpp"
+
+#include <unordered_map>
+
+
+namespace {
+    // A small config parsed over and over: the same few hundred keys in every parse.
+    std::string generate_config() {
+        std::string config;
+
+        for (int table = 0; table < 20; ++table) {
+            config += "[service_" + std::to_string(table) + "]\n";
+
+            for (int key = 0; key < 15; ++key) {
+                config += "connection_setting_" + std::to_string(key) + " = " + std::to_string(table * key) + "\n";
+            }
+        }
+
+        return config;
+    }
+
+    // Keys are looked up by name, as handlers mapping keys to fields usually do.
+    struct string_keys_handler_t {
+        const std::unordered_map<std::string, std::size_t> &fields;
+        std::size_t matched;
+
+        explicit string_keys_handler_t(const std::unordered_map<std::string, std::size_t> &fields) :
+            fields(fields),
+            matched(0)
+        { }
+
+        void key(const std::string &key) {
+            matched += fields.count(key);
+        }
+    };
+
+    struct interned_keys_handler_t {
+        const std::vector<bool> &fields;
+        std::size_t matched;
+
+        explicit interned_keys_handler_t(const std::vector<bool> &fields) :
+            fields(fields),
+            matched(0)
+        { }
+
+        void key(const loltoml::interned_key_t &key) {
+            matched += key.id < fields.size() && fields[key.id];
+        }
+    };
+
+    void BM_ConfigStringKeys(benchmark::State &state) {
+        std::string config = generate_config();
+        std::unordered_map<std::string, std::size_t> fields;
+
+        for (int key = 0; key < 15; key += 2) {
+            fields.emplace("connection_setting_" + std::to_string(key), fields.size());
+        }
+
+        for (auto _ : state) {
+            string_keys_handler_t handler(fields);
+            loltoml::parse(config.data(), config.data() + config.size(), handler);
+            benchmark::DoNotOptimize(handler.matched);
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * config.size()));
+    }
+
+    void BM_ConfigInternedKeys(benchmark::State &state) {
+        std::string config = generate_config();
+        loltoml::key_interner_t interner;
+        std::vector<bool> fields;
+
+        for (int key = 0; key < 15; key += 2) {
+            std::uint32_t id = interner.intern("connection_setting_" + std::to_string(key)).id;
+            fields.resize(id + 1);
+            fields[id] = true;
+        }
+
+        loltoml::parse_options_t options;
+        options.key_interner = &interner;
+
+        for (auto _ : state) {
+            interned_keys_handler_t handler(fields);
+            loltoml::parse(config.data(), config.data() + config.size(), handler, options);
+            benchmark::DoNotOptimize(handler.matched);
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * config.size()));
+    }
+}
+
+
+BENCHMARK(BM_ConfigStringKeys);
+BENCHMARK(BM_ConfigInternedKeys);
@@ -0,0 +1,134 @@
+#include "common.hpp"
+
+#include "loltoml/key_schema.hpp"
+
+#include <map>
+
+
+namespace {
+    // A service config of a known schema: 20 sections of 15 settings, a handler wants half of them.
+    std::string generate_config() {
+        std::string config;
+
+        for (int table = 0; table < 20; ++table) {
+            config += "[service_" + std::to_string(table) + "]\n";
+
+            for (int key = 0; key < 15; ++key) {
+                config += "connection_setting_" + std::to_string(key) + " = " + std::to_string(table * key) + "\n";
+            }
+        }
+
+        return config;
+    }
+
+    std::vector<std::string> wanted_paths() {
+        std::vector<std::string> paths;
+
+        for (int table = 0; table < 20; ++table) {
+            for (int key = 0; key < 15; key += 2) {
+                paths.push_back("service_" + std::to_string(table) + ".connection_setting_" + std::to_string(key));
+            }
+        }
+
+        return paths;
+    }
+
+    // Builds the path of every key and looks it up in a map, as handlers like ConfigReader::TOMLHandler do.
+    struct map_handler_t {
+        const std::map<std::string, std::size_t> &fields;
+        std::string prefix;
+        std::string path;
+        std::int64_t sum;
+        std::size_t current;
+
+        explicit map_handler_t(const std::map<std::string, std::size_t> &fields) :
+            fields(fields),
+            sum(0),
+            current(0)
+        { }
+
+        void table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
+            prefix.clear();
+
+            for (; begin != end; ++begin) {
+                prefix += *begin + ".";
+            }
+        }
+
+        loltoml::action_t key(const std::string &key) {
+            path = prefix + key;
+            auto it = fields.find(path);
+
+            if (it == fields.end()) {
+                return loltoml::action_t::skip;
+            }
+
+            current = it->second;
+            return loltoml::action_t::proceed;
+        }
+
+        void integer(std::int64_t value) {
+            sum += value * static_cast<std::int64_t>(current);
+        }
+    };
+
+    struct schema_handler_t {
+        std::int64_t sum;
+        std::size_t current;
+
+        schema_handler_t() :
+            sum(0),
+            current(0)
+        { }
+
+        loltoml::action_t key(const loltoml::schema_key_t &key) {
+            if (key.index == loltoml::key_schema_t::npos) {
+                return loltoml::action_t::skip;
+            }
+
+            current = key.index;
+            return loltoml::action_t::proceed;
+        }
+
+        void integer(std::int64_t value) {
+            sum += value * static_cast<std::int64_t>(current);
+        }
+    };
+
+    void BM_ConfigMapPaths(benchmark::State &state) {
+        std::string config = generate_config();
+        std::vector<std::string> paths = wanted_paths();
+        std::map<std::string, std::size_t> fields;
+
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            fields.emplace(paths[i], i);
+        }
+
+        for (auto _ : state) {
+            map_handler_t handler(fields);
+            loltoml::parse(config.data(), config.data() + config.size(), handler);
+            benchmark::DoNotOptimize(handler.sum);
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * config.size()));
+    }
+
+    void BM_ConfigSchemaPaths(benchmark::State &state) {
+        std::string config = generate_config();
+        loltoml::key_schema_t schema(wanted_paths());
+        loltoml::parse_options_t options;
+        options.key_schema = &schema;
+
+        for (auto _ : state) {
+            schema_handler_t handler;
+            loltoml::parse(config.data(), config.data() + config.size(), handler, options);
+            benchmark::DoNotOptimize(handler.sum);
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * config.size()));
+    }
+}
+
+
+BENCHMARK(BM_ConfigMapPaths);
+BENCHMARK(BM_ConfigSchemaPaths);
@@ -0,0 +1,116 @@
+#include "common.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+namespace {
+    std::string integer_array(std::size_t size) {
+        std::mt19937_64 random(42);
+        std::string document = "values = [";
+
+        for (std::size_t i = 0; i < size; ++i) {
+            if (i > 0) {
+                document += ", ";
+            }
+
+            document += std::to_string(static_cast<std::int64_t>(random()) >> (random() % 63));
+        }
+
+        return document + "]\n";
+    }
+
+    std::vector<std::string> float_values(std::size_t size) {
+        std::mt19937_64 random(42);
+        std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+        std::vector<std::string> values;
+
+        for (std::size_t i = 0; i < size; ++i) {
+            char value[32];
+            std::snprintf(value, sizeof(value), "%.6f", distribution(random));
+            values.push_back(value);
+        }
+
+        return values;
+    }
+
+    std::string float_array(std::size_t size) {
+        std::vector<std::string> values = float_values(size);
+        std::string document = "values = [";
+
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (i > 0) {
+                document += ", ";
+            }
+
+            document += values[i];
+        }
+
+        return document + "]\n";
+    }
+
+    // The same work parse_number() does for a float token without underscores and exponent.
+    double convert(const std::string &value) {
+        loltoml::detail::decimal_t decimal;
+        bool negative = (value[0] == '-');
+        bool fractional = false;
+
+        for (std::size_t i = negative ? 1 : 0; i < value.size(); ++i) {
+            if (value[i] == '.') {
+                fractional = true;
+            } else {
+                decimal.append(static_cast<unsigned int>(value[i] - '0'), fractional);
+            }
+        }
+
+        double result;
+
+        if (!loltoml::detail::decimal_to_double(decimal, negative, &result)) {
+            result = loltoml::detail::strtod_c_locale(value);
+        }
+
+        return result;
+    }
+
+    template<class Converter>
+    void convert_values(benchmark::State &state, Converter converter) {
+        std::vector<std::string> values = float_values(static_cast<std::size_t>(state.range(0)));
+        std::size_t bytes = 0;
+
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            bytes += values[i].size();
+        }
+
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                benchmark::DoNotOptimize(converter(values[i]));
+            }
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+    }
+}
+
+
+static void BM_IntegerArray(benchmark::State &state) {
+    parse_document(state, integer_array(static_cast<std::size_t>(state.range(0))));
+}
+BENCHMARK(BM_IntegerArray)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_FloatArray(benchmark::State &state) {
+    parse_document(state, float_array(static_cast<std::size_t>(state.range(0))));
+}
+BENCHMARK(BM_FloatArray)->Arg(1 << 10)->Arg(1 << 16);
+
+// Conversion of float tokens alone: the built-in conversion against the std::strtod() it replaced.
+static void BM_FloatConversion(benchmark::State &state) {
+    convert_values(state, convert);
+}
+BENCHMARK(BM_FloatConversion)->Arg(1 << 16);
+
+static void BM_FloatConversionStrtod(benchmark::State &state) {
+    convert_values(state, [](const std::string &value) { return std::strtod(value.c_str(), nullptr); });
+}
+BENCHMARK(BM_FloatConversionStrtod)->Arg(1 << 16);
@@ -0,0 +1,73 @@
+#include "common.hpp"
+#include "corpus.hpp"
+
+#include "loltoml/reader.hpp"
+
+
+namespace {
+    // SAX-handler receiving the same zero-copy strings as the reader, to compare the two fairly.
+    struct string_ref_handler_t {
+        typedef loltoml::string_ref_t string_type;
+
+        string_ref_handler_t() :
+            events(0)
+        { }
+
+        void comment(loltoml::string_ref_t) { ++events; }
+        void array_table(loltoml::key_iterator_t, loltoml::key_iterator_t) { ++events; }
+        void table(loltoml::key_iterator_t, loltoml::key_iterator_t) { ++events; }
+        void key(loltoml::string_ref_t) { ++events; }
+        void start_array() { ++events; }
+        void finish_array(std::size_t) { ++events; }
+        void start_inline_table() { ++events; }
+        void finish_inline_table(std::size_t) { ++events; }
+        void boolean(bool) { ++events; }
+        void string(loltoml::string_ref_t) { ++events; }
+        void datetime(loltoml::string_ref_t) { ++events; }
+        void integer(std::int64_t) { ++events; }
+        void floating_point(double) { ++events; }
+        void symbol(loltoml::string_ref_t) { ++events; }
+
+        std::size_t events;
+    };
+
+    void BM_Sax(benchmark::State &state, corpus_kind_t kind) {
+        std::string document = generate_corpus(kind, static_cast<std::size_t>(state.range(0)));
+        std::size_t events = 0;
+
+        for (auto _ : state) {
+            string_ref_handler_t handler;
+            loltoml::parse(document.data(), document.data() + document.size(), handler);
+            events = handler.events;
+        }
+
+        report_speed(state, document.size(), events);
+    }
+
+    void BM_Reader(benchmark::State &state, corpus_kind_t kind) {
+        std::string document = generate_corpus(kind, static_cast<std::size_t>(state.range(0)));
+        std::size_t events = 0;
+
+        for (auto _ : state) {
+            loltoml::reader_t reader(document.data(), document.data() + document.size());
+            events = 0;
+
+            while (reader.next()) {
+                benchmark::DoNotOptimize(reader.event().type);
+                ++events;
+            }
+        }
+
+        report_speed(state, document.size(), events);
+    }
+}
+
+
+BENCHMARK_CAPTURE(BM_Sax, basic_strings, corpus_kind_t::basic_strings)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Reader, basic_strings, corpus_kind_t::basic_strings)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Sax, inline_tables, corpus_kind_t::inline_tables)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Reader, inline_tables, corpus_kind_t::inline_tables)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Sax, deep_tables, corpus_kind_t::deep_tables)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Reader, deep_tables, corpus_kind_t::deep_tables)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Sax, mixed, corpus_kind_t::mixed)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Reader, mixed, corpus_kind_t::mixed)->Arg(1 << 20);
@@ -0,0 +1,59 @@
+#include "common.hpp"
+#include "corpus.hpp"
+
+
+namespace {
+    // Reads 5 settings of one service from a large shared config and skips everything else.
+    struct service_settings_handler_t {
+        service_settings_handler_t() :
+            in_service(false),
+            settings(0)
+        { }
+
+        loltoml::action_t table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
+            in_service = (end - begin == 1 && *begin == "service");
+            return in_service ? loltoml::action_t::proceed : loltoml::action_t::skip;
+        }
+
+        loltoml::action_t array_table(loltoml::key_iterator_t, loltoml::key_iterator_t) {
+            in_service = false;
+            return loltoml::action_t::skip;
+        }
+
+        loltoml::action_t key(const std::string &) {
+            return in_service ? loltoml::action_t::proceed : loltoml::action_t::skip;
+        }
+
+        void integer(std::int64_t) {
+            ++settings;
+        }
+
+        bool in_service;
+        std::size_t settings;
+    };
+
+    std::string shared_config(std::size_t size) {
+        std::string document = generate_corpus(corpus_kind_t::mixed, size);
+        document += "[service]\na = 1\nb = 2\nc = 3\nd = 4\ne = 5\n";
+        return document;
+    }
+}
+
+
+static void BM_SharedConfigFull(benchmark::State &state) {
+    parse_document(state, shared_config(static_cast<std::size_t>(state.range(0))));
+}
+BENCHMARK(BM_SharedConfigFull)->Arg(20 << 20)->Unit(benchmark::kMillisecond);
+
+static void BM_SharedConfigSkip(benchmark::State &state) {
+    std::string document = shared_config(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        service_settings_handler_t handler;
+        loltoml::parse(document.data(), document.data() + document.size(), handler);
+        benchmark::DoNotOptimize(handler.settings);
+    }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+}
+BENCHMARK(BM_SharedConfigSkip)->Arg(20 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,38 @@
+#include "common.hpp"
+#include "corpus.hpp"
+
+#include <sstream>
+
+
+namespace {
+    // A small header section at the top of a large file, as read by sidecars.
+    std::string file_with_header(std::size_t size) {
+        return "[header]\nversion = 3\nowner = \"storage\"\n\n" + generate_corpus(corpus_kind_t::mixed, size);
+    }
+
+    void parse_stream(benchmark::State &state, const loltoml::parse_options_t &options) {
+        std::string document = file_with_header(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state) {
+            std::istringstream input(document);
+            null_handler_t handler;
+            loltoml::parse(input, handler, options);
+            benchmark::DoNotOptimize(handler.events);
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+    }
+}
+
+
+static void BM_HeaderFullStream(benchmark::State &state) {
+    parse_stream(state, loltoml::parse_options_t());
+}
+BENCHMARK(BM_HeaderFullStream)->Arg(20 << 20)->Unit(benchmark::kMillisecond);
+
+static void BM_HeaderStopAfterKeys(benchmark::State &state) {
+    loltoml::parse_options_t options;
+    options.stop_after_keys = {{"header", "version"}, {"header", "owner"}};
+    parse_stream(state, options);
+}
+BENCHMARK(BM_HeaderStopAfterKeys)->Arg(20 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,32 @@
+#include "common.hpp"
+
+
+namespace {
+    // Long values like embedded certificates or SQL snippets.
+    std::string long_strings_document(std::size_t size, const char *open, const char *close) {
+        std::string value;
+
+        for (std::size_t i = 0; value.size() < 2000; ++i) {
+            value += "SELECT column_" + std::to_string(i) + " FROM table WHERE id = 42; ";
+        }
+
+        std::string document;
+
+        for (std::size_t i = 0; i < size; ++i) {
+            document += "value_" + std::to_string(i) + " = " + open + value + close + "\n";
+        }
+
+        return document;
+    }
+}
+
+
+static void BM_LongBasicStrings(benchmark::State &state) {
+    parse_document(state, long_strings_document(static_cast<std::size_t>(state.range(0)), "\"", "\""));
+}
+BENCHMARK(BM_LongBasicStrings)->Arg(1 << 8)->Arg(1 << 12);
+
+static void BM_LongLiteralStrings(benchmark::State &state) {
+    parse_document(state, long_strings_document(static_cast<std::size_t>(state.range(0)), "'", "'"));
+}
+BENCHMARK(BM_LongLiteralStrings)->Arg(1 << 8)->Arg(1 << 12);
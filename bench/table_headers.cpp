@@ -0,0 +1,41 @@
+#include "common.hpp"
+
+
+namespace {
+    // Every entry repeats the same header, the worst case for building header paths.
+    std::string generate_array_tables(std::size_t entries) {
+        std::string document;
+
+        for (std::size_t i = 0; i < entries; ++i) {
+            document += "[[cluster.servers.backend]]\nweight = ";
+            document += std::to_string(i);
+            document += "\n";
+        }
+
+        return document;
+    }
+
+    struct headers_handler_t {
+        std::size_t keys = 0;
+
+        void array_table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
+            keys += static_cast<std::size_t>(end - begin);
+        }
+    };
+
+    void BM_ArrayTableHeaders(benchmark::State &state) {
+        std::string document = generate_array_tables(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state) {
+            headers_handler_t handler;
+            loltoml::parse(document.data(), document.data() + document.size(), handler);
+            benchmark::DoNotOptimize(handler.keys);
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * state.range(0)));
+    }
+}
+
+
+BENCHMARK(BM_ArrayTableHeaders)->Arg(100000);
@@ -0,0 +1,87 @@
+#include "common.hpp"
+#include "corpus.hpp"
+
+#include "loltoml/document.hpp"
+#include "loltoml/tape_document.hpp"
+
+
+namespace {
+    std::int64_t sum_integers(const loltoml::value_t &value) {
+        std::int64_t sum = 0;
+
+        for (const loltoml::member_t &member: value) {
+            if (member.value.type() == loltoml::value_type_t::integer) {
+                sum += member.value.as_integer();
+            } else if (member.value.type() == loltoml::value_type_t::table || member.value.type() == loltoml::value_type_t::array) {
+                sum += sum_integers(member.value);
+            }
+        }
+
+        return sum;
+    }
+
+    void BM_TapeBuild(benchmark::State &state, corpus_kind_t kind) {
+        std::string document = generate_corpus(kind, static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state) {
+            loltoml::tape_document_t tape = loltoml::parse_tape(document.data(), document.data() + document.size());
+            benchmark::DoNotOptimize(tape.tape().data());
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+    }
+
+    void BM_DocumentBuild(benchmark::State &state, corpus_kind_t kind) {
+        std::string document = generate_corpus(kind, static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state) {
+            loltoml::document_t dom = loltoml::parse_document(document.data(), document.data() + document.size());
+            benchmark::DoNotOptimize(dom.root().size());
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+    }
+
+    // Full traversal of a parsed document, summing all integers.
+    void BM_TapeTraverse(benchmark::State &state, corpus_kind_t kind) {
+        std::string document = generate_corpus(kind, static_cast<std::size_t>(state.range(0)));
+        loltoml::tape_document_t tape = loltoml::parse_tape(document.data(), document.data() + document.size());
+
+        for (auto _ : state) {
+            std::int64_t sum = 0;
+
+            for (std::size_t index = 0; index < tape.tape().size(); ++index) {
+                if (tape.type(index) == loltoml::tape_type_t::integer) {
+                    sum += tape.integer_at(index++);
+                } else if (tape.type(index) == loltoml::tape_type_t::floating_point) {
+                    ++index;
+                }
+            }
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+    }
+
+    void BM_DocumentTraverse(benchmark::State &state, corpus_kind_t kind) {
+        std::string document = generate_corpus(kind, static_cast<std::size_t>(state.range(0)));
+        loltoml::document_t dom = loltoml::parse_document(document.data(), document.data() + document.size());
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(sum_integers(dom.root()));
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+    }
+}
+
+
+BENCHMARK_CAPTURE(BM_TapeBuild, mixed, corpus_kind_t::mixed)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_DocumentBuild, mixed, corpus_kind_t::mixed)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_TapeBuild, integers, corpus_kind_t::integers)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_DocumentBuild, integers, corpus_kind_t::integers)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_TapeTraverse, mixed, corpus_kind_t::mixed)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_DocumentTraverse, mixed, corpus_kind_t::mixed)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_TapeTraverse, integers, corpus_kind_t::integers)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_DocumentTraverse, integers, corpus_kind_t::integers)->Arg(1 << 20);
@@ -0,0 +1,35 @@
+#include "common.hpp"
+
+
+namespace {
+    // A localized config: keys are ASCII, most comments and strings are not.
+    std::string localized_document(std::size_t size) {
+        std::string document;
+
+        for (std::size_t i = 0; i < size; ++i) {
+            document += "# Параметр номер " + std::to_string(i) + ", описание на русском языке\n";
+            document += "title_" + std::to_string(i) + " = \"Заголовок \xe2\x80\x94 значение по умолчанию\"\n";
+            document += "path_" + std::to_string(i) + " = '/usr/share/application/data'\n";
+            document += "enabled_" + std::to_string(i) + " = true\n\n";
+        }
+
+        return document;
+    }
+
+    loltoml::parse_options_t validating_options() {
+        loltoml::parse_options_t options;
+        options.validate_utf8 = true;
+        return options;
+    }
+}
+
+
+static void BM_LocalizedDocument(benchmark::State &state) {
+    parse_document(state, localized_document(static_cast<std::size_t>(state.range(0))));
+}
+BENCHMARK(BM_LocalizedDocument)->Arg(1 << 14);
+
+static void BM_LocalizedDocumentValidateUtf8(benchmark::State &state) {
+    parse_document(state, localized_document(static_cast<std::size_t>(state.range(0))), validating_options());
+}
+BENCHMARK(BM_LocalizedDocumentValidateUtf8)->Arg(1 << 14);
@@ -0,0 +1,24 @@
+#include "common.hpp"
+#include "corpus.hpp"
+
+#include "loltoml/validate.hpp"
+
+
+namespace {
+    void BM_Validate(benchmark::State &state, corpus_kind_t kind) {
+        std::string document = generate_corpus(kind, static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(loltoml::validate(document.data(), document.data() + document.size()));
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+    }
+}
+
+
+// Compare with BM_Corpus on the same documents.
+BENCHMARK_CAPTURE(BM_Validate, basic_strings, corpus_kind_t::basic_strings)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Validate, deep_tables, corpus_kind_t::deep_tables)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Validate, comments, corpus_kind_t::comments)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Validate, mixed, corpus_kind_t::mixed)->Arg(1 << 20);
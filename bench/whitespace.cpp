@@ -0,0 +1,43 @@
+#include "common.hpp"
+
+
+namespace {
+    // Resembles generated configs: every value is indented and documented with a comment.
+    std::string commented_document(std::size_t size) {
+        std::string document;
+
+        for (std::size_t i = 0; i < size; ++i) {
+            document += "\n# Setting number " + std::to_string(i) + ". This comment was generated by a tool,\n";
+            document += "# and it explains the value below in a lot of detail.\n";
+            document += "[section_" + std::to_string(i) + "]\n";
+            document += "        value = " + std::to_string(i) + "            # trailing comment\n";
+            document += "        \n\n";
+        }
+
+        return document;
+    }
+
+    // Doesn't have comment(), so the parser skips building comments.
+    struct values_handler_t {
+        void key(const std::string &) { }
+        void integer(std::int64_t) { }
+    };
+}
+
+
+static void BM_CommentedDocument(benchmark::State &state) {
+    parse_document(state, commented_document(static_cast<std::size_t>(state.range(0))));
+}
+BENCHMARK(BM_CommentedDocument)->Arg(1 << 10)->Arg(1 << 14);
+
+static void BM_CommentedDocumentWithoutCommentCallback(benchmark::State &state) {
+    std::string document = commented_document(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        values_handler_t handler;
+        loltoml::parse(document.data(), document.data() + document.size(), handler);
+    }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * document.size()));
+}
+BENCHMARK(BM_CommentedDocumentWithoutCommentCallback)->Arg(1 << 14);
@@ -20,19 +20,39 @@ inline std::ostream& operator<<(std::ostream& stream, std::map<X, Y> map) noexce
 }
 
 
+inline std::ostream& operator<<(std::ostream& stream, const ConfigReader::FlatConfig& configs) noexcept {
+    stream << "{ ";
+    bool first = true;
+    configs.forEach([&](loltoml::string_ref_t key, const ConfigReader::TOMLValue& value) {
+        if (!first) {
+            stream << ", ";
+        }
+        stream << key.str() << " = " << value;
+        first = false;
+    });
+    return stream << " }";
+}
+
+
 int main(int argc, char** argv) {
-    if (argc < 2) {
+    bool flat = argc == 3 && std::string(argv[1]) == "--flat";
+    if (argc < 2 || (argc > 2 && !flat)) {
         std::cerr << "How to call:\n"
-            << "\t" << argv[0] << " toml_file"
+            << "\t" << argv[0] << " [--flat] toml_file"
             << std::endl;
         return EXIT_FAILURE;
     }
 
-    std::ifstream f(argv[1]);
     try {
-        std::map<std::string, ConfigReader::TOMLValue> configs = ConfigReader::parse(f);
         std::cout << std::boolalpha;
-        std::cout << configs << std::endl;
+        if (flat) {
+            // Keys in order of their first definition, stored in a flat hash map.
+            ConfigReader::FlatConfig configs = ConfigReader::parseFlat(std::string(argv[2]));
+            std::cout << configs << std::endl;
+        } else {
+            std::map<std::string, ConfigReader::TOMLValue> configs = ConfigReader::parse(std::string(argv[1]));
+            std::cout << configs << std::endl;
+        }
     }
     catch (const loltoml::parser_error_t& e) {
         std::cerr << e.message() << std::endl;
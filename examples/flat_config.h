@@ -0,0 +1,301 @@
+#pragma once
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#pragma clang diagnostic ignored "-Wpadded"
+#include "loltoml/key_interner.hpp"
+#pragma clang diagnostic pop
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "toml_value.h"
+
+namespace ConfigReader {
+  class FlatTOMLHandler;
+
+  /**
+   * Stores the key-value pairs of a configuration file in a flat hash map.
+   *
+   * Keys are interned by the parser in a `loltoml::key_interner_t`, an
+   * open-addressing hash table, and the ids of the keys index a vector of
+   * handles to the values.  Looking a key up is a single probe of the hash
+   * table followed by two indexing operations, instead of a walk down the
+   * nodes of a `std::map`.
+   *
+   * Keys set to symbols share the handle of the referenced value, so a string
+   * referenced by many keys is stored once.  A symbol referencing a key that
+   * is defined later in the file gets the final value of that key.
+   *
+   * Pairs are visited by `forEach` in the order their keys first appeared in
+   * the file, not sorted by key.
+   *
+   * This class is filled by `FlatTOMLHandler`, see `parseFlat`.
+   */
+  class FlatConfig {
+  public:
+    /**
+     * Look up the value of a key.
+     *
+     * @param key The key to look up.
+     * @return A pointer to the value, or `nullptr` if the key is undefined.
+     */
+    const TOMLValue* find(const std::string& key) const {
+      return get(keys_.find(key));
+    }
+
+    /**
+     * Look up the value of a key.
+     *
+     * @param key The key to look up.
+     * @return The value of the key.
+     * @throws std::out_of_range if the key is undefined.
+     */
+    const TOMLValue& at(const std::string& key) const {
+      const TOMLValue* value = find(key);
+      if (value == nullptr) {
+        throw std::out_of_range("Key \"" + key + "\" is undefined.");
+      }
+      return *value;
+    }
+
+    /**
+     * @param key The key to look up.
+     * @return 1 if the key is defined, 0 otherwise, like `std::map::count`.
+     */
+    std::size_t count(const std::string& key) const {
+      return find(key) == nullptr ? 0 : 1;
+    }
+
+    /**
+     * @return The number of defined keys.
+     */
+    std::size_t size() const noexcept {
+      return size_;
+    }
+
+    /**
+     * @return Whether no key is defined.
+     */
+    bool empty() const noexcept {
+      return size_ == 0;
+    }
+
+    /**
+     * Call `function(key, value)` for every key-value pair, in the order the
+     * keys first appeared in the file.  The key is a `loltoml::string_ref_t`.
+     */
+    template <typename Function>
+    void forEach(Function function) const {
+      for (std::uint32_t id = 0; id < slots_.size(); ++id) {
+        if (const TOMLValue* value = get(id)) {
+          function(keys_.name(id), *value);
+        }
+      }
+    }
+
+  private:
+    friend class FlatTOMLHandler;
+
+    /**
+     * `undefined` is the slot of keys without a value.  `pending` flags slots
+     * holding the index of an unresolved reference in `references_` instead of
+     * the index of a value.
+     */
+    enum : std::uint32_t {
+      undefined = 0xFFFFFFFF,
+      pending = 0x80000000
+    };
+
+    /**
+     * A symbol referencing a key without a value yet: a key that was not
+     * defined yet, or a key set to another unresolved symbol.
+     */
+    struct Reference {
+      /**
+       * Id of the key set to the symbol.
+       */
+      std::uint32_t source;
+
+      /**
+       * Id of the referenced key.
+       */
+      std::uint32_t target;
+
+      /**
+       * The `pending` slot of the target when the symbol was read, or
+       * `undefined` if the target was not defined yet.
+       */
+      std::uint32_t shared;
+    };
+
+    /**
+     * @return The slot of an interned key.
+     */
+    std::uint32_t slot(std::uint32_t id) const {
+      return id < slots_.size() ? slots_[id] : undefined;
+    }
+
+    /**
+     * Bind an interned key to a slot, if the key is undefined.
+     */
+    void bind(std::uint32_t id, std::uint32_t slot) {
+      if (id >= slots_.size()) {
+        slots_.resize(id + 1, undefined);
+      }
+      if (slots_[id] == undefined) {
+        ++size_;
+      }
+      slots_[id] = slot;
+    }
+
+    /**
+     * Look up the value of an interned key.
+     *
+     * The parser interns keys before their values are known, so an interned
+     * key is only defined once a value was stored under its id.
+     */
+    const TOMLValue* get(std::uint32_t id) const {
+      std::uint32_t index = slot(id);
+      if (index == undefined || (index & pending) != 0) {
+        return nullptr;
+      }
+      return &values_[index];
+    }
+
+    /**
+     * Store a value under an interned key, replacing the previous one.
+     *
+     * The previous value is kept, symbols may still share it.
+     */
+    void assign(std::uint32_t id, const TOMLValue& value) {
+      values_.push_back(value);
+      bind(id, static_cast<std::uint32_t>(values_.size() - 1));
+    }
+
+    /**
+     * Make an interned key share the value of the key `target`, unless the key
+     * is already defined.
+     *
+     * A defined target is shared with its current value.  Otherwise a
+     * reference is recorded for the key and resolved by `resolve`: to the
+     * value the target has at the end of the document if it was not defined
+     * yet, or to the value of the symbol the target is currently set to.
+     */
+    void alias(std::uint32_t id, const std::string& target) {
+      std::uint32_t target_id = keys_.intern(target).id;
+      std::uint32_t shared = slot(target_id);
+      if (shared == undefined || (shared & pending) != 0) {
+        references_.push_back(Reference{id, target_id, shared});
+        shared = pending | static_cast<std::uint32_t>(references_.size() - 1);
+      }
+      if (slot(id) == undefined) {
+        bind(id, shared);
+      }
+    }
+
+    /**
+     * Resolve the recorded references, after the whole document was stored.
+     *
+     * A reference resolves to the value of its target, which may be another
+     * reference.  Chains of references are followed until a value, and
+     * every reference on the chain resolves to it, so each reference is
+     * followed once.
+     *
+     * @throws std::runtime_error if a target is never defined, or if references
+     * form a cycle.
+     */
+    void resolve() {
+      std::vector<std::uint32_t> resolved(references_.size(), undefined);
+      std::vector<bool> visited(references_.size(), false);
+      std::vector<std::uint32_t> chain;
+
+      for (std::uint32_t reference = 0; reference < references_.size(); ++reference) {
+        std::uint32_t current = reference;
+        std::uint32_t value = undefined;
+        chain.clear();
+
+        while (true) {
+          if (resolved[current] != undefined) {
+            value = resolved[current];
+            break;
+          }
+          if (visited[current]) {
+            throw std::runtime_error("Symbols reference each other: " + cycle(chain, current) + ".");
+          }
+          visited[current] = true;
+          chain.push_back(current);
+
+          std::uint32_t target = references_[current].shared;
+          if (target == undefined) {
+            target = slot(references_[current].target);
+          }
+          if (target == undefined) {
+            throw std::runtime_error("Identifier \"" + keys_.name(references_[current].target).str()
+                + "\" on right hand side of =, but undefined.");
+          }
+          if ((target & pending) == 0) {
+            value = target;
+            break;
+          }
+          current = target & ~pending;
+        }
+
+        for (std::uint32_t link : chain) {
+          resolved[link] = value;
+        }
+      }
+
+      for (std::uint32_t& index : slots_) {
+        if (index != undefined && (index & pending) != 0) {
+          index = resolved[index & ~pending];
+        }
+      }
+      references_.clear();
+    }
+
+    /**
+     * @return The keys set to the symbols on a chain from `start`, joined
+     * like `a -> b -> a`.
+     */
+    std::string cycle(const std::vector<std::uint32_t>& chain, std::uint32_t start) const {
+      std::string result;
+      for (std::size_t i = 0; i < chain.size(); ++i) {
+        if (chain[i] == start || !result.empty()) {
+          result += keys_.name(references_[chain[i]].source).str() + " -> ";
+        }
+      }
+      return result + keys_.name(references_[start].source).str();
+    }
+
+    /**
+     * The keys, their ids are the indices of their slots in `slots_`.
+     */
+    loltoml::key_interner_t keys_;
+
+    /**
+     * Index of the value of every interned key in `values_`, `undefined`, or
+     * a `pending` reference while parsing.  Symbols share the index of the
+     * value they reference instead of copying it.
+     */
+    std::vector<std::uint32_t> slots_;
+
+    /**
+     * Values stored in the document, in order.
+     */
+    std::vector<TOMLValue> values_;
+
+    /**
+     * One reference per symbol read while its target had no value, while
+     * parsing.
+     */
+    std::vector<Reference> references_;
+
+    /**
+     * The number of defined keys.
+     */
+    std::size_t size_ = 0;
+  };
+}
@@ -0,0 +1,184 @@
+#include <loltoml/key_schema.hpp>
+#include <loltoml/parse.hpp>
+
+#include <cstdio>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+/*
+ * This is a generator of key schemas (see loltoml::key_schema_t).
+ * It reads a sample document and writes a header with a constexpr list of its key paths
+ * and an enum of their indices, e.g. for `key_schema_generator config < config.toml`:
+ *
+ *     constexpr const char *config_keys[] = {
+ *         "title",
+ *         "server.port",
+ *     };
+ *
+ *     enum config_key_t : std::uint32_t {
+ *         config_title = 0,
+ *         config_server_port = 1,
+ *     };
+ *
+ * A handler then parses with `loltoml::key_schema_t schema(config_keys)` in loltoml::parse_options_t::key_schema
+ * and switches on the enum in `key(const loltoml::schema_key_t &key)`.
+ */
+
+
+namespace {
+
+// Collects key paths in order of their first appearance, by the same rules as the parser uses for schemas.
+class paths_collector_t {
+public:
+    typedef loltoml::string_ref_t string_type;
+
+    std::vector<std::string> paths;
+
+    void start_document() {
+        m_prefixes.assign(1, prefix_t{std::string(), false});
+    }
+
+    void table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
+        std::string prefix;
+
+        for (; begin != end; ++begin) {
+            prefix += *begin + ".";
+        }
+
+        m_prefixes.assign(1, prefix_t{prefix, false});
+    }
+
+    void array_table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
+        table(begin, end);
+    }
+
+    void key(loltoml::string_ref_t key) {
+        m_path = m_prefixes.back().prefix + key.str();
+
+        if (m_known.insert(m_path).second) {
+            paths.push_back(m_path);
+        }
+    }
+
+    void start_array() {
+        start_container(true);
+    }
+
+    void finish_array(std::size_t) {
+        m_prefixes.pop_back();
+    }
+
+    void start_inline_table() {
+        start_container(false);
+    }
+
+    void finish_inline_table(std::size_t) {
+        m_prefixes.pop_back();
+    }
+
+private:
+    struct prefix_t {
+        std::string prefix;
+        bool array;
+    };
+
+    // Elements of arrays have the path of the array.
+    void start_container(bool array) {
+        prefix_t container = m_prefixes.back();
+
+        if (!container.array) {
+            container.prefix = m_path + ".";
+        }
+
+        container.array = array;
+        m_prefixes.push_back(container);
+    }
+
+    std::vector<prefix_t> m_prefixes;
+    std::string m_path;
+    std::set<std::string> m_known;
+};
+
+std::string identifier(const std::string &name, const std::string &path) {
+    std::string result = name + "_";
+
+    for (char c: path) {
+        bool alphanumeric = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        result += alphanumeric ? c : '_';
+    }
+
+    return result;
+}
+
+void write_literal(std::ostream &output, const std::string &value) {
+    output << '"';
+
+    for (char c: value) {
+        if (c == '"' || c == '\\') {
+            output << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\%03o", static_cast<unsigned>(c));
+            output << escaped;
+        } else {
+            output << c;
+        }
+    }
+
+    output << '"';
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::string name = argc > 1 ? argv[1] : "config";
+
+    try {
+        paths_collector_t collector;
+        loltoml::parse(std::cin, collector);
+
+        if (collector.paths.empty()) {
+            std::cerr << "The document has no keys" << std::endl;
+            return 1;
+        }
+
+        // Checks that the paths can be told apart.
+        loltoml::key_schema_t schema(collector.paths);
+        std::set<std::string> identifiers;
+
+        for (const std::string &path: collector.paths) {
+            if (!identifiers.insert(identifier(name, path)).second) {
+                std::cerr << "Paths differing only in punctuation have the same name " << identifier(name, path) << std::endl;
+                return 1;
+            }
+        }
+
+        std::cout << "// Key paths of " << name << ", generated by key_schema_generator.\n"
+                  << "// Their indices in loltoml::key_schema_t(" << name << "_keys) are the values of " << name << "_key_t.\n\n"
+                  << "constexpr const char *" << name << "_keys[] = {\n";
+
+        for (const std::string &path: collector.paths) {
+            std::cout << "    ";
+            write_literal(std::cout, path);
+            std::cout << ",\n";
+        }
+
+        std::cout << "};\n\n" << "enum " << name << "_key_t : std::uint32_t {\n";
+
+        for (std::uint32_t i = 0; i < schema.size(); ++i) {
+            std::cout << "    " << identifier(name, collector.paths[i]) << " = " << i << ",\n";
+        }
+
+        std::cout << "};" << std::endl;
+    } catch (const loltoml::parser_error_t &e) {
+        std::cerr << "Error at offset " << e.offset() << ": " << e.message() << std::endl;
+        return 1;
+    } catch (const std::exception &e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
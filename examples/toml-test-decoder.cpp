@@ -5,20 +5,19 @@
 #include <boost/lexical_cast.hpp>
 
 #include <iostream>
-#include <set>
 #include <stack>
 #include <vector>
 
 /*
  * This example implements a TOML decoder which can be used with the test suite from https://github.com/BurntSushi/toml-test
- * It adds key uniqueness ensurance on top of the SAX parser and therefore implements 100% spec compliant TOML parser.
+ * Uniqueness of keys is checked by the parser (loltoml::parse_options_t::check_duplicate_keys),
+ * so it implements 100% spec compliant TOML parser.
  * Actually it builds kind of DOM, but rather unuseful for practical purposes.
  * It uses class kora::dynamic_t from https://github.com/leonidia/util to store the DOM.
  */
 
 
 struct handler_t {
-    std::set<std::vector<std::string>> assigned_keys;
     std::vector<std::string> path;
     kora::dynamic_t result;
     std::stack<kora::dynamic_t*> stack;
@@ -76,7 +75,6 @@ struct handler_t {
 
     void array_table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
         path.assign(begin, end);
-        assigned_keys.insert(path);
 
         while (!stack.empty()) {
             stack.pop();
@@ -121,10 +119,6 @@ struct handler_t {
     void table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
         path.assign(begin, end);
 
-        if (!assigned_keys.insert(path).second) {
-            throw std::exception();
-        }
-
         while (!stack.empty()) {
             stack.pop();
         }
@@ -150,12 +144,6 @@ struct handler_t {
 
     void key(const std::string &key) {
         path.push_back(key);
-
-        if (path.size() == stack.size()) {
-            if (!assigned_keys.insert(path).second) {
-                throw std::exception();
-            }
-        }
     }
 
     void start_array() {
@@ -206,7 +194,9 @@ struct handler_t {
 int main() {
     try {
         handler_t handler;
-        loltoml::parse(std::cin, handler);
+        loltoml::parse_options_t options;
+        options.check_duplicate_keys = true;
+        loltoml::parse(std::cin, handler, options);
 
         kora::write_pretty_json(std::cout, handler.result);
     } catch (const std::exception &e) {
@@ -9,14 +9,18 @@
 #pragma clang diagnostic ignored "-Wpadded"
 #pragma clang diagnostic ignored "-Wshadow"
 #pragma clang diagnostic ignored "-Wweak-vtables"
+#include "loltoml/datetime.hpp"
 #include "loltoml/parse.hpp"
+#include "loltoml/parse_file.hpp"
 #pragma clang diagnostic pop
 
 #include <fstream>
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
+#include "flat_config.h"
 #include "toml_value.h"
 
 namespace ConfigReader {
@@ -55,6 +59,43 @@ namespace ConfigReader {
    */
   inline std::map<std::string, TOMLValue> parse(const std::string& filename);
 
+  /**
+   * Create a flat hash map of the key-value pairs in a "TOML+" configuration
+   * file.
+   *
+   * Same as `parse`, but the pairs are stored in a `FlatConfig`, which looks
+   * keys up with a single probe of a hash table.  Prefer it when the
+   * configuration is queried often after parsing.
+   *
+   * Keys set to symbols share the referenced values instead of copying them.
+   * A symbol may also reference a key defined later in the file, it then gets
+   * the last value of that key:
+   *
+   *    ```
+   *    second = first  # first = false, second = false
+   *    first = true
+   *    third = first   # first = false, second = false, third = true
+   *    first = false
+   *    ```
+   *
+   * Symbols referencing keys that are never defined, and symbols referencing
+   * each other in a cycle, result in a `std::runtime_error` after the whole
+   * file was read.
+   *
+   * @seealso `FlatConfig`
+   * @param input An input stream that stores the TOML data.
+   * @return A flat map of the keys in the TOML data, to their values.
+   */
+  inline FlatConfig parseFlat(std::istream& input);
+
+  /** Create a flat hash map of the key-value pairs in a "TOML+" configuration
+   * file.
+   *
+   * @param filename Name of the TOML file.
+   * @return A flat map of the keys in the TOML data, to their values.
+   */
+  inline FlatConfig parseFlat(const std::string& filename);
+
 
   /** 
    * Error thrown when the `TOMLHandler` encounters unsupported TOML expressions.
@@ -66,50 +107,13 @@ namespace ConfigReader {
 
 
   /**
-   * Stores parsed data of a TOML file in a `std::map<string, TOMLValue>`.
-   * 
-   * This class implements the interface required by the `loltoml` parser.  Each 
-   * function is called on a parsing event.  It is required to deliver an 
-   * implementation of each of these functions.  Not handling that event equals
-   * providing an empty implementation.
-   * 
-   * The handler has only implemented a part of the TOML v0.4.0 specification.
-   * The following sections of the TOML v0.4.0 specification are handled:
-   *   - [Comment](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#comment)
-   *   - [String](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#string)
-   *   - [Integer](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#integer)
-   *   - [Float](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#float)
-   *   - [Boolean](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#boolean)
-   *   
-   * The following sections of the TOML v0.4.0 specification have not yet been 
-   * implemented in the handler:
-   *   - [Datetime](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#datetime), 
-   *     including "Offset Date-Time", "Local Date-Time", "Local Date" and "Local 
-   *     Time" - [see here](https://github.com/toml-lang/toml/blob/709e9e9ee91ba3c10f8613241b1497349803f4f4/README.md)
-   *   - [Array](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#array)
-   *   - [Table](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#table)
-   *   - [Inline Table](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#inline-table)
-   *   - [Array of Tables](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#array-of-tables)
-   * 
-   * This class is used by `parseConfig` for `loltoml::parse`.
+   * The TOML expressions that are not supported by the handlers yet.
+   *
+   * Both `TOMLHandler` and `FlatTOMLHandler` inherit these parsing events,
+   * each of which throws an `UnsupportedTOMLExpressionError`.
    */
-  class TOMLHandler {
+  class UnsupportedTOMLExpressions {
   public:
-    /**
-     * No initialisation on start of document needed.
-     */
-    void start_document() { }
-
-    /**
-     * No finalisation on end of document needed.
-     */
-    void finish_document() { }
-
-    /**
-     * Do not store comments.
-     */
-    void comment(const std::string&) { }
-
     /**
      * Unsupported yet!
      */
@@ -151,7 +155,39 @@ namespace ConfigReader {
     void finish_inline_table(std::size_t) __attribute__((noreturn)) {
       throw UnsupportedTOMLExpressionError("inline table");
     }
+  };
+
 
+  /**
+   * Stores parsed data of a TOML file in a `std::map<string, TOMLValue>`.
+   * 
+   * This class implements the interface required by the `loltoml` parser.  Each 
+   * function is called on a parsing event.  Events without a function are 
+   * skipped: there are no `start_document`, `finish_document` and `comment`, so
+   * the parser does not even copy comments.
+   * 
+   * The handler has only implemented a part of the TOML v0.4.0 specification.
+   * The following sections of the TOML v0.4.0 specification are handled:
+   *   - [Comment](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#comment)
+   *   - [String](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#string)
+   *   - [Integer](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#integer)
+   *   - [Float](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#float)
+   *   - [Boolean](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#boolean)
+   *   - [Datetime](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#datetime), 
+   *     including "Offset Date-Time", "Local Date-Time", "Local Date" and "Local 
+   *     Time" - [see here](https://github.com/toml-lang/toml/blob/709e9e9ee91ba3c10f8613241b1497349803f4f4/README.md)
+   *   
+   * The following sections of the TOML v0.4.0 specification have not yet been 
+   * implemented in the handler:
+   *   - [Array](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#array)
+   *   - [Table](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#table)
+   *   - [Inline Table](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#inline-table)
+   *   - [Array of Tables](https://github.com/toml-lang/toml/blob/master/versions/en/toml-v0.4.0.md#array-of-tables)
+   * 
+   * This class is used by `parseConfig` for `loltoml::parse`.
+   */
+  class TOMLHandler : public UnsupportedTOMLExpressions {
+  public:
     /**
      * Register the key for the next value insertion in the `std::map`.
      */
@@ -174,10 +210,10 @@ namespace ConfigReader {
     }
 
     /**
-     * Unsupported yet!
+     * Store `curr_key_` with this value with this type.
      */
-    void datetime(const std::string& /*value*/) __attribute__((noreturn)) {
-      throw UnsupportedTOMLExpressionError("datetime");
+    void datetime(const loltoml::datetime_t& value) {
+      configs_[curr_key_] = TOMLValue(value);
     }
 
     /**
@@ -198,11 +234,12 @@ namespace ConfigReader {
      * Store `curr_key_` with this value with this type.
      */
     void symbol(const std::string &value) {
-      if (configs_.find(value) == configs_.end()) {
+      auto referenced = configs_.find(value);
+      if (referenced == configs_.end()) {
         throw std::runtime_error("Identifier \"" + value
             + "\" on right hand side of =, but undefined.");
       }
-      configs_.emplace(curr_key_, configs_.at(value));
+      configs_.emplace(curr_key_, referenced->second);
     }
 
     /**
@@ -218,11 +255,106 @@ namespace ConfigReader {
   };
 
 
+  /**
+   * Stores parsed data of a TOML file in a `FlatConfig`.
+   *
+   * The same as `TOMLHandler`, except that the parser interns the keys in the
+   * `FlatConfig` (see `loltoml::parse_options_t::key_interner`) and passes
+   * their ids to `key`, so a value is stored without looking its key up.
+   *
+   * Symbols are not copied: a key set to a symbol shares the value of the
+   * referenced key.  Symbols referencing keys that are not defined yet are
+   * recorded, and resolved at `finish_document` to the final values of these
+   * keys.
+   *
+   * This class is used by `parseFlat` for `loltoml::parse`.
+   */
+  class FlatTOMLHandler : public UnsupportedTOMLExpressions {
+  public:
+    /**
+     * Options for `loltoml::parse` that intern the keys in `configs_`.
+     */
+    loltoml::parse_options_t options() {
+      loltoml::parse_options_t options;
+      options.key_interner = &configs_.keys_;
+      return options;
+    }
+
+    /**
+     * Register the id of the key for the next value insertion in `configs_`.
+     */
+    void key(const loltoml::interned_key_t &key) {
+      curr_key_ = key.id;
+    }
+
+    /**
+     * Store `curr_key_` with this value with this type.
+     */
+    void boolean(bool value) {
+      configs_.assign(curr_key_, value);
+    }
+
+    /**
+     * Store `curr_key_` with this value with this type.
+     */
+    void string(const std::string& value) {
+      configs_.assign(curr_key_, TOMLValue(value));
+    }
+
+    /**
+     * Store `curr_key_` with this value with this type.
+     */
+    void datetime(const loltoml::datetime_t& value) {
+      configs_.assign(curr_key_, TOMLValue(value));
+    }
+
+    /**
+     * Store `curr_key_` with this value with this type.
+     */
+    void integer(long long value) {
+      configs_.assign(curr_key_, static_cast<std::int64_t>(value));
+    }
+
+    /**
+     * Store `curr_key_` with this value with this type.
+     */
+    void floating_point(double value) {
+      configs_.assign(curr_key_, value);
+    }
+
+    /**
+     * Store `curr_key_` with this value with this type.
+     */
+    void symbol(const std::string &value) {
+      configs_.alias(curr_key_, value);
+    }
+
+    /**
+     * Resolve the symbols referencing keys defined after them.
+     */
+    void finish_document() {
+      configs_.resolve();
+    }
+
+    /**
+     * The storage for all configuration key-value pairs, which also interns
+     * the keys.
+     */
+    FlatConfig configs_;
+
+  private:
+    /**
+     * Store the next value under the key with this id.
+     */
+    std::uint32_t curr_key_ = 0;
+  };
+
+
   // This function might throw the following exceptions:
   //   - loltoml::parser_error_t if the stream does not represent a proper TOML
   //     file.
   //   - UnsupportedTOMLExpressionError if the TOMLHandler does not know how to
-  //     handle a TOML expression, such as DateTime.
+  //     handle a TOML expression, such as an array.
   //   - any std::exception that might be thrown when handling streams
   inline std::map<std::string, TOMLValue> parse(std::istream& input) {
     ConfigReader::TOMLHandler handler;
@@ -230,8 +362,25 @@ namespace ConfigReader {
     return handler.configs_;
   }
 
+  // The file is memory-mapped and parsed in place.  A file that cannot be
+  // opened results in a loltoml::file_error_t.
   inline std::map<std::string, TOMLValue> parse(const std::string& filename) {
-    std::ifstream file(filename);
-    return parse(file);
+    ConfigReader::TOMLHandler handler;
+    loltoml::parse_file(filename.c_str(), handler);
+    return handler.configs_;
+  }
+
+  // Throws the same exceptions as parse(std::istream&), a std::runtime_error
+  // for undefined or cyclic symbols is only thrown at the end of the stream.
+  inline FlatConfig parseFlat(std::istream& input) {
+    ConfigReader::FlatTOMLHandler handler;
+    loltoml::parse(input, handler, handler.options());
+    return std::move(handler.configs_);
+  }
+
+  inline FlatConfig parseFlat(const std::string& filename) {
+    ConfigReader::FlatTOMLHandler handler;
+    loltoml::parse_file(filename.c_str(), handler, handler.options());
+    return std::move(handler.configs_);
   }
 }
@@ -4,6 +4,8 @@
 #include <stdexcept>
 #include <string>
 
+#include "loltoml/datetime.hpp"
+
 namespace ConfigReader {
   /**
    * Stores a single value of any of the following types:
@@ -12,6 +14,7 @@ namespace ConfigReader {
    * - std::string
    * - std::int64_t
    * - double
+   * - loltoml::datetime_t
    *
    * This class accomplishes this by storing the data in a union, and storing
    * type information in the form of an enum value.
@@ -32,8 +35,7 @@ namespace ConfigReader {
       empty,
       boolean,
       string,
-      // TODO: Uncomment when implementing support for TOML datetime values
-      //datetime,
+      datetime,
       integer,
       floating_point
     };
@@ -47,6 +49,7 @@ namespace ConfigReader {
      * - `Type::empty`: no cast available
      * - `Type::boolean`: cast to `bool`
      * - `Type::string`: cast to `std::string`
+     * - `Type::datetime`: cast to `loltoml::datetime_t`
      * - `Type::integer`: cast to `std::int64_t`. Casting to `short`, `int`,
      *   `long`,`std::int8_t`, `std::int16_t`, `std::int32_t`, `float`, or
      *   `double` is accepted but beware for overflow errors.
@@ -147,6 +150,16 @@ namespace ConfigReader {
       as_string_(value)
     {}
 
+    /**
+     * Creates a new TOMLValue that stores a `loltoml::datetime_t`.
+     * 
+     * @param value The value to store.
+     */
+    TOMLValue(const loltoml::datetime_t& value) :
+      type_(Type::datetime),
+      as_datetime_(value)
+    {}
+
     /**
      * Type conversion operator to `bool`.
      *
@@ -307,6 +320,20 @@ namespace ConfigReader {
       return as_string_;
     }
 
+    /**
+     * Type conversion operator to `loltoml::datetime_t`.
+     *
+     * This will succeed if `type_` equals `TOMLValue::Type::datetime`.
+     * Otherwise, this function raises an exception of type
+     * `std::domain_error`.
+     */
+    operator loltoml::datetime_t() const {
+      if (type_ != Type::datetime) {
+        throw std::domain_error("A TOMLValue with type_ == " + type_string() + " cannot be cast to loltoml::datetime_t");
+      }
+      return as_datetime_;
+    }
+
     /** 
      * Copy constructor.
      */
@@ -326,11 +353,9 @@ namespace ConfigReader {
           new (&as_string_) std::basic_string<char>;
           as_string_ = other.as_string_;
           break;
-        // TODO: Uncomment when implementing support for TOML datetime values
-        //case Type::datetime:
-        //    new (&as_datetime_) datetime_t();
-        //    as_datetime_ = other.as_datetime_;
-        //    break;
+        case Type::datetime:
+          as_datetime_ = other.as_datetime_;
+          break;
         case Type::integer:
           as_integer_ = other.as_integer_;
           break;
@@ -369,11 +394,9 @@ namespace ConfigReader {
           new (&as_string_) std::basic_string<char>;
           as_string_ = other.as_string_;
           break;
-        // TODO: Uncomment when implementing support for TOML datetime values
-        //case Type::datetime:
-        //    new (&as_datetime_) datetime_t();
-        //    as_datetime_ = other.as_datetime_;
-        //    break;
+        case Type::datetime:
+          as_datetime_ = other.as_datetime_;
+          break;
         case Type::integer:
           as_integer_ = other.as_integer_;
           break;
@@ -398,16 +421,13 @@ namespace ConfigReader {
       switch (type_) {
         case Type::empty:
         case Type::boolean:
+        case Type::datetime:
         case Type::integer:
         case Type::floating_point:
           break;
         case Type::string:
           as_string_.~basic_string<char>();
           break;
-        // TODO: Uncomment when implementing support for TOML datetime values
-        //case Type::datetime:
-        //    as_datetime_.~datetime_t();
-        //    break;
       }
     }
 
@@ -429,8 +449,7 @@ namespace ConfigReader {
       std::int64_t as_integer_;
       double as_floating_point_;
       std::string as_string_;
-      // TODO: implement as_datetime_ with a std::chrono::time_point
-      //datetime_t as_datetime_;
+      loltoml::datetime_t as_datetime_;
     };
 
     /**
@@ -444,9 +463,8 @@ namespace ConfigReader {
           return "TOMLValue::Type::boolean";
         case TOMLValue::Type::string:
           return "TOMLValue::Type::string";
-        // TODO: Uncomment when implementing support for TOML datetime values
-        //case TOMLValue::Type::datetime:
-        //  return "TOMLValue::Type::datetime";
+        case TOMLValue::Type::datetime:
+          return "TOMLValue::Type::datetime";
         case TOMLValue::Type::integer:
           return "TOMLValue::Type::integer";
         case TOMLValue::Type::floating_point:
@@ -515,10 +533,9 @@ inline std::ostream& operator<<(std::ostream& stream, ConfigReader::TOMLValue va
     case ConfigReader::TOMLValue::Type::boolean:
       return stream << bool(value);
     case ConfigReader::TOMLValue::Type::string:
-      return stream << "\"" << escape_string(value) << "\"";
-    // TODO: Uncomment when implementing support for TOML datetime values
-    //case TOMLValue::Type::datetime:
-    //    return stream << value.as_datetime_;
+      return stream << "\"" << ConfigReader::escape_string(value) << "\"";
+    case ConfigReader::TOMLValue::Type::datetime:
+      return stream << loltoml::datetime_t(value);
     case ConfigReader::TOMLValue::Type::integer:
       return stream << std::int64_t(value);
     case ConfigReader::TOMLValue::Type::floating_point:
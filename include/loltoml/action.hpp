@@ -0,0 +1,30 @@
+#ifndef LOLTOML_ACTION_HPP
+#define LOLTOML_ACTION_HPP
+
+#include "loltoml/detail/common.hpp"
+
+LOLTOML_OPEN_NAMESPACE
+
+
+/*! What the parser should do after an event.
+ *
+ * Methods of the handler may return it instead of void (see loltoml::parse()).
+ */
+enum class action_t {
+    //! Continue parsing as usual.
+    proceed,
+    /*! Skip the value of the key, or the whole section after a table header (up to the next header),
+     *  without feeding any events to the handler and without validating the skipped text.
+     *  Only key(), table() and array_table() may return it, it means proceed for the other methods.
+     */
+    skip,
+    /*! Stop parsing right away: the rest of the input isn't read, finish_document() is called
+     *  and the parsing function returns normally.
+     */
+    stop
+};
+
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_ACTION_HPP
@@ -0,0 +1,595 @@
+#ifndef LOLTOML_BIND_HPP
+#define LOLTOML_BIND_HPP
+
+#include "loltoml/action.hpp"
+#include "loltoml/datetime.hpp"
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/handler_traits.hpp"
+#include "loltoml/detail/hash.hpp"
+#include "loltoml/error.hpp"
+#include "loltoml/parse.hpp"
+#include "loltoml/parse_options.hpp"
+#include "loltoml/string_ref.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+struct field_type_t;
+
+
+// A field of a bound struct, an element of a bound array or the struct passed to parse_into() itself.
+struct field_t {
+    void *pointer;
+    const field_type_t *type;
+    // Name of the field in LOLTOML_BIND, for error messages.
+    const char *name;
+};
+
+
+// Operations on fields of some type, see field_operations. They throw bind_error_t if the value doesn't fit the field.
+struct field_type_t {
+    void (*boolean)(const field_t &field, bool value);
+    void (*integer)(const field_t &field, std::int64_t value);
+    void (*floating_point)(const field_t &field, double value);
+    void (*string)(const field_t &field, string_ref_t value);
+    void (*datetime)(const field_t &field, const datetime_t &value);
+    // Removes old elements of an array before the new ones are appended.
+    void (*clear)(const field_t &field);
+    // Appends a value-initialized element to an array.
+    field_t (*append)(const field_t &field);
+    // Checks that an inline table may be assigned to the field.
+    void (*start_table)(const field_t &field);
+    // Returns the table a header goes through: the field itself or the last element of an array of tables.
+    field_t (*section)(const field_t &field);
+    // Finds a member of a table, false if the table has no such member.
+    bool (*find)(const field_t &field, string_ref_t key, field_t &member);
+};
+
+
+[[noreturn]] inline void throw_mismatch(const field_t &field, const char *value) {
+    throw bind_error_t(std::string("Field \"") + field.name + "\" cannot hold " + value);
+}
+
+
+// Operations of a field which accepts nothing, field_operations override those it supports.
+struct mismatch_operations_t {
+    static void boolean(const field_t &field, bool) {
+        throw_mismatch(field, "a boolean");
+    }
+
+    static void integer(const field_t &field, std::int64_t) {
+        throw_mismatch(field, "an integer");
+    }
+
+    static void floating_point(const field_t &field, double) {
+        throw_mismatch(field, "a float");
+    }
+
+    static void string(const field_t &field, string_ref_t) {
+        throw_mismatch(field, "a string");
+    }
+
+    static void datetime(const field_t &field, const datetime_t &) {
+        throw_mismatch(field, "a datetime");
+    }
+
+    static void clear(const field_t &field) {
+        throw_mismatch(field, "an array");
+    }
+
+    static field_t append(const field_t &field) {
+        throw_mismatch(field, "an array");
+    }
+
+    static void start_table(const field_t &field) {
+        throw_mismatch(field, "a table");
+    }
+
+    static field_t section(const field_t &field) {
+        throw_mismatch(field, "a table");
+    }
+
+    static bool find(const field_t &field, string_ref_t, field_t &) {
+        throw_mismatch(field, "a table");
+    }
+};
+
+
+// True if LOLTOML_BIND (or a hand-written loltoml_find_field()) binds the type.
+template<class T, class = void>
+struct has_binding : std::false_type { };
+
+template<class T>
+struct has_binding<
+    T,
+    typename always_void<decltype(loltoml_find_field(std::declval<T &>(), std::declval<string_ref_t>(), std::declval<field_t &>()))>::type
+> : std::true_type { };
+
+
+template<class T>
+const field_type_t *field_type();
+
+
+// Operations on fields of type T. Fields of unsupported types don't compile.
+template<class T, class = void>
+struct field_operations;
+
+template<>
+struct field_operations<bool> : mismatch_operations_t {
+    static void boolean(const field_t &field, bool value) {
+        *static_cast<bool *>(field.pointer) = value;
+    }
+};
+
+template<class T>
+struct field_operations<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> :
+    mismatch_operations_t
+{
+    static void integer(const field_t &field, std::int64_t value) {
+        T converted = static_cast<T>(value);
+
+        if (static_cast<std::int64_t>(converted) != value || (value < 0 && !std::is_signed<T>::value)) {
+            throw bind_error_t("Value " + std::to_string(value) + " is out of range of field \"" + field.name + "\"");
+        }
+
+        *static_cast<T *>(field.pointer) = converted;
+    }
+};
+
+// Integers are accepted too: "timeout = 5" is a natural way to write 5.0.
+template<class T>
+struct field_operations<T, typename std::enable_if<std::is_floating_point<T>::value>::type> : mismatch_operations_t {
+    static void integer(const field_t &field, std::int64_t value) {
+        *static_cast<T *>(field.pointer) = static_cast<T>(value);
+    }
+
+    static void floating_point(const field_t &field, double value) {
+        *static_cast<T *>(field.pointer) = static_cast<T>(value);
+    }
+};
+
+template<>
+struct field_operations<std::string> : mismatch_operations_t {
+    static void string(const field_t &field, string_ref_t value) {
+        static_cast<std::string *>(field.pointer)->assign(value.data(), value.size());
+    }
+};
+
+template<>
+struct field_operations<datetime_t> : mismatch_operations_t {
+    static void datetime(const field_t &field, const datetime_t &value) {
+        *static_cast<datetime_t *>(field.pointer) = value;
+    }
+};
+
+template<class T, class Allocator>
+struct field_operations<std::vector<T, Allocator>> : mismatch_operations_t {
+    static_assert(!std::is_same<T, bool>::value, "std::vector<bool> has no addressable elements and cannot be bound");
+
+    static void clear(const field_t &field) {
+        static_cast<std::vector<T, Allocator> *>(field.pointer)->clear();
+    }
+
+    static field_t append(const field_t &field) {
+        std::vector<T, Allocator> *array = static_cast<std::vector<T, Allocator> *>(field.pointer);
+        array->emplace_back();
+        return field_t{&array->back(), field_type<T>(), field.name};
+    }
+
+    // [servers.tls] after [[servers]] goes through the last server.
+    static field_t section(const field_t &field) {
+        std::vector<T, Allocator> *array = static_cast<std::vector<T, Allocator> *>(field.pointer);
+
+        if (array->empty()) {
+            throw_mismatch(field, "a table");
+        }
+
+        field_t item{&array->back(), field_type<T>(), field.name};
+        return item.type->section(item);
+    }
+};
+
+template<class T>
+struct field_operations<T, typename std::enable_if<has_binding<T>::value>::type> : mismatch_operations_t {
+    static void start_table(const field_t &) { }
+
+    static field_t section(const field_t &field) {
+        return field;
+    }
+
+    static bool find(const field_t &field, string_ref_t key, field_t &member) {
+        return loltoml_find_field(*static_cast<T *>(field.pointer), key, member);
+    }
+};
+
+
+template<class T>
+inline const field_type_t *field_type() {
+    typedef field_operations<T> operations;
+
+    static const field_type_t type = {
+        &operations::boolean,
+        &operations::integer,
+        &operations::floating_point,
+        &operations::string,
+        &operations::datetime,
+        &operations::clear,
+        &operations::append,
+        &operations::start_table,
+        &operations::section,
+        &operations::find
+    };
+
+    return &type;
+}
+
+
+// Called by the functions generated by LOLTOML_BIND for a key having the hash of the name.
+template<class T>
+inline bool bind_field(T &value, const char *name, string_ref_t key, field_t &field) {
+    // Keys which aren't bound may have the same hash.
+    if (key != string_ref_t(name)) {
+        return false;
+    }
+
+    field.pointer = &value;
+    field.type = field_type<T>();
+    field.name = name;
+    return true;
+}
+
+
+/*
+ * SAX-handler filling a bound struct.
+ * Fields are reached through field_t, so a single parser is instantiated for all bound types.
+ * Keys and tables without fields are skipped by the parser.
+ */
+class binder_t {
+public:
+    typedef string_ref_t string_type;
+
+    explicit binder_t(field_t root) :
+        m_root(root),
+        m_value()
+    { }
+
+    void start_document() {
+        m_stack.assign(1, container_t{m_root, false});
+        m_cleared_arrays.clear();
+    }
+
+    action_t table(key_iterator_t begin, key_iterator_t end) {
+        field_t field;
+
+        if (!find_path(begin, end, field)) {
+            return action_t::skip;
+        }
+
+        m_stack.assign(1, container_t{field.type->section(field), false});
+        return action_t::proceed;
+    }
+
+    action_t array_table(key_iterator_t begin, key_iterator_t end) {
+        field_t field;
+
+        if (!find_path(begin, end, field)) {
+            return action_t::skip;
+        }
+
+        // Tables of the document replace the elements the array had before parsing.
+        std::vector<std::string> path(begin, end);
+
+        if (std::find(m_cleared_arrays.begin(), m_cleared_arrays.end(), path) == m_cleared_arrays.end()) {
+            field.type->clear(field);
+            m_cleared_arrays.push_back(path);
+        }
+
+        // Headers below this one now go through the new element, whose arrays haven't been cleared yet.
+        m_cleared_arrays.erase(
+            std::remove_if(m_cleared_arrays.begin(), m_cleared_arrays.end(), [&path](const std::vector<std::string> &cleared) {
+                return cleared.size() > path.size() && std::equal(path.begin(), path.end(), cleared.begin());
+            }),
+            m_cleared_arrays.end()
+        );
+
+        field_t item = field.type->append(field);
+        m_stack.assign(1, container_t{item.type->section(item), false});
+        return action_t::proceed;
+    }
+
+    action_t key(string_ref_t key) {
+        const field_t &table = m_stack.back().field;
+        return table.type->find(table, key, m_value) ? action_t::proceed : action_t::skip;
+    }
+
+    void start_array() {
+        field_t field = value_field();
+        field.type->clear(field);
+        m_stack.push_back(container_t{field, true});
+    }
+
+    void finish_array(std::size_t) {
+        m_stack.pop_back();
+    }
+
+    void start_inline_table() {
+        field_t field = value_field();
+        field.type->start_table(field);
+        m_stack.push_back(container_t{field, false});
+    }
+
+    void finish_inline_table(std::size_t) {
+        m_stack.pop_back();
+    }
+
+    void boolean(bool value) {
+        field_t field = value_field();
+        field.type->boolean(field, value);
+    }
+
+    void string(string_ref_t value) {
+        field_t field = value_field();
+        field.type->string(field, value);
+    }
+
+    void datetime(const datetime_t &value) {
+        field_t field = value_field();
+        field.type->datetime(field, value);
+    }
+
+    void integer(std::int64_t value) {
+        field_t field = value_field();
+        field.type->integer(field, value);
+    }
+
+    void floating_point(double value) {
+        field_t field = value_field();
+        field.type->floating_point(field, value);
+    }
+
+    void symbol(string_ref_t) {
+        throw_mismatch(value_field(), "a symbol");
+    }
+
+private:
+    struct container_t {
+        field_t field;
+        bool array;
+    };
+
+    // Finds the field named by a table header, false if some of its keys aren't bound.
+    bool find_path(key_iterator_t begin, key_iterator_t end, field_t &field) {
+        field = m_root;
+
+        for (; begin != end; ++begin) {
+            field_t table = field.type->section(field);
+
+            if (!table.type->find(table, *begin, field)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // The field of the next value: the field of the current key, or a new element of the current array.
+    field_t value_field() {
+        const container_t &container = m_stack.back();
+        return container.array ? container.field.type->append(container.field) : m_value;
+    }
+
+private:
+    field_t m_root;
+    // Innermost container is at the back, the table of the last header is at the front.
+    std::vector<container_t> m_stack;
+    field_t m_value;
+    // Paths of the arrays of tables already cleared by their first header, in the last elements of the enclosing arrays.
+    // They are keyed by path since an address may be reused by a new element once the enclosing array reallocates.
+    std::vector<std::vector<std::string>> m_cleared_arrays;
+};
+
+
+#define LOLTOML_DETAIL_CONCAT(a, b) LOLTOML_DETAIL_CONCAT_HELPER(a, b)
+#define LOLTOML_DETAIL_CONCAT_HELPER(a, b) a##b
+
+// Number of the arguments, up to 64. The trailing 0 keeps the variadic part of COUNT_HELPER non-empty.
+#define LOLTOML_DETAIL_COUNT(...) \
+    LOLTOML_DETAIL_COUNT_HELPER(__VA_ARGS__, \
+        64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49,\
+        48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33,\
+        32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,\
+        16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1,\
+        0)
+#define LOLTOML_DETAIL_COUNT_HELPER( \
+        a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16,\
+        a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32,\
+        a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48,\
+        a49, a50, a51, a52, a53, a54, a55, a56, a57, a58, a59, a60, a61, a62, a63, a64,\
+        count, ...) count
+
+// Applies the macro to every argument.
+#define LOLTOML_DETAIL_FOR_EACH(macro, ...) \
+    LOLTOML_DETAIL_CONCAT(LOLTOML_DETAIL_FOR_EACH_, LOLTOML_DETAIL_COUNT(__VA_ARGS__))(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_1(macro, x) macro(x)
+#define LOLTOML_DETAIL_FOR_EACH_2(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_1(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_3(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_2(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_4(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_3(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_5(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_4(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_6(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_5(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_7(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_6(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_8(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_7(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_9(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_8(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_10(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_9(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_11(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_10(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_12(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_11(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_13(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_12(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_14(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_13(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_15(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_14(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_16(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_15(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_17(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_16(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_18(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_17(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_19(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_18(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_20(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_19(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_21(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_20(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_22(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_21(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_23(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_22(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_24(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_23(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_25(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_24(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_26(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_25(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_27(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_26(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_28(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_27(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_29(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_28(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_30(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_29(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_31(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_30(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_32(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_31(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_33(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_32(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_34(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_33(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_35(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_34(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_36(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_35(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_37(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_36(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_38(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_37(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_39(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_38(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_40(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_39(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_41(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_40(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_42(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_41(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_43(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_42(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_44(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_43(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_45(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_44(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_46(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_45(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_47(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_46(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_48(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_47(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_49(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_48(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_50(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_49(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_51(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_50(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_52(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_51(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_53(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_52(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_54(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_53(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_55(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_54(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_56(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_55(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_57(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_56(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_58(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_57(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_59(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_58(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_60(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_59(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_61(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_60(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_62(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_61(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_63(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_62(macro, __VA_ARGS__)
+#define LOLTOML_DETAIL_FOR_EACH_64(macro, x, ...) macro(x) LOLTOML_DETAIL_FOR_EACH_63(macro, __VA_ARGS__)
+
+#define LOLTOML_DETAIL_BIND_FIELD(name)                                                 \
+    case ::loltoml::detail::hash_string(#name):                                         \
+        return ::loltoml::detail::bind_field(object.name, #name, key, field);
+
+
+} // namespace detail
+
+
+/*! Binds fields of a struct to keys of the same names, for loltoml::parse_into().
+ *
+ * It must be used in the namespace of the struct: `LOLTOML_BIND(server_t, host, port, tls);`
+ * It defines a function found by argument-dependent lookup, which dispatches keys with a switch over hashes of the names
+ * computed at compile time, so a key is hashed once and compared with a single name.
+ * Names with colliding hashes fail to compile as duplicate case labels. Up to 64 fields may be bound.
+ *
+ * Supported types of fields:
+ * - bool;
+ * - integral types, integers out of their range are rejected;
+ * - floating-point types, they accept integers too;
+ * - std::string;
+ * - loltoml::datetime_t;
+ * - std::vector of supported types (except bool), filled from arrays or arrays of tables;
+ * - other bound structs, filled from tables or inline tables.
+ */
+#define LOLTOML_BIND(type, ...)                                                                                            \
+    inline bool loltoml_find_field(type &object, ::loltoml::string_ref_t key, ::loltoml::detail::field_t &field) {         \
+        switch (::loltoml::detail::hash_bytes(key.data(), key.size())) {                                                   \
+            LOLTOML_DETAIL_FOR_EACH(LOLTOML_DETAIL_BIND_FIELD, __VA_ARGS__)                                                \
+        }                                                                                                                  \
+                                                                                                                           \
+        return false;                                                                                                      \
+    }                                                                                                                      \
+                                                                                                                           \
+    inline bool loltoml_find_field(type &object, ::loltoml::string_ref_t key, ::loltoml::detail::field_t &field)
+
+
+/*! Parse a TOML document from a buffer into a struct bound with LOLTOML_BIND.
+ *
+ * Values are assigned to the fields right from the events of the parser, without a DOM or a map of keys.
+ * Keys and tables without fields are skipped without building their values.
+ * Fields missing from the document keep their values, so the object may hold the defaults
+ * (or the previous configuration being reloaded). Arrays replace the old elements.
+ *
+ * \tparam T Type of the object, bound with LOLTOML_BIND.
+ * \param[in] begin Pointer to the first byte of the document. It must be utf-8 encoded.
+ * \param[in] end Pointer past the last byte of the document.
+ * \param[in, out] object Object to fill.
+ * \param[in] options Features to enable, see loltoml::parse_options_t.
+ * \throws loltoml::parser_error_t if the buffer contains an invalid TOML document.
+ * \throws loltoml::bind_error_t if a value doesn't fit its field.
+ */
+template<class T>
+inline void parse_into(const char *begin, const char *end, T &object, const parse_options_t &options = parse_options_t()) {
+    static_assert(detail::has_binding<T>::value, "The type must be bound with LOLTOML_BIND");
+
+    detail::binder_t binder(detail::field_t{&object, detail::field_type<T>(), ""});
+    parse(begin, end, binder, options);
+}
+
+
+/*! Parse a TOML document from a buffer into a value-initialized struct bound with LOLTOML_BIND.
+ *
+ * See the previous overload.
+ */
+template<class T>
+inline T parse_into(const char *begin, const char *end, const parse_options_t &options = parse_options_t()) {
+    T object = T();
+    parse_into(begin, end, object, options);
+    return object;
+}
+
+
+/*! Parse a TOML document from a stream into a struct bound with LOLTOML_BIND.
+ *
+ * \tparam T Type of the object, bound with LOLTOML_BIND.
+ * \param[in, out] input Stream containing a TOML document. It must be utf-8 encoded.
+ * \param[in, out] object Object to fill.
+ * \param[in] options Features to enable, see loltoml::parse_options_t.
+ * \throws loltoml::parser_error_t if the input contains an invalid TOML document.
+ * \throws loltoml::bind_error_t if a value doesn't fit its field.
+ * \throws loltoml::stream_error_t if input.bad() becomes true.
+ */
+template<class T>
+inline void parse_into(std::istream &input, T &object, const parse_options_t &options = parse_options_t()) {
+    static_assert(detail::has_binding<T>::value, "The type must be bound with LOLTOML_BIND");
+
+    detail::binder_t binder(detail::field_t{&object, detail::field_type<T>(), ""});
+    parse(input, binder, options);
+}
+
+
+/*! Parse a TOML document from a stream into a value-initialized struct bound with LOLTOML_BIND.
+ *
+ * See the previous overload.
+ */
+template<class T>
+inline T parse_into(std::istream &input, const parse_options_t &options = parse_options_t()) {
+    T object = T();
+    parse_into(input, object, options);
+    return object;
+}
+
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_BIND_HPP
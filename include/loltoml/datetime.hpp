@@ -0,0 +1,322 @@
+#ifndef LOLTOML_DATETIME_HPP
+#define LOLTOML_DATETIME_HPP
+
+#include "loltoml/detail/common.hpp"
+#include "loltoml/string_ref.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+LOLTOML_OPEN_NAMESPACE
+
+
+//! Kinds of datetimes, see loltoml::datetime_t.
+enum class datetime_kind_t : std::uint8_t {
+    //! A date and a time with an offset from UTC: 1979-05-27T07:32:00Z, 1979-05-27T00:32:00.999-07:00.
+    offset_datetime,
+    //! A date and a time without an offset: 1979-05-27T07:32:00.
+    local_datetime,
+    //! 1979-05-27
+    local_date,
+    //! 07:32:00.999
+    local_time
+};
+
+
+/*! A datetime value of a TOML document (RFC 3339 date-times, dates and times).
+ *
+ * The value is 24 bytes and trivially copyable. Fields missing from its kind are zero.
+ * Fields are validated: days exist in their months, hours are below 24 etc. Seconds may be 60 for leap seconds.
+ */
+struct datetime_t {
+    /*! Seconds since 1970-01-01T00:00:00Z for offset date-times.
+     *
+     * Local date-times and dates count from 1970-01-01T00:00:00 in their own unknown timezone,
+     * local times count seconds since midnight. The fraction of the second is in nanosecond.
+     */
+    std::int64_t epoch_seconds;
+    //! Fraction of the second, digits past the 9th are dropped.
+    std::uint32_t nanosecond;
+    //! Offset from UTC in minutes, e.g. -420 for -07:00. Zero for Z.
+    std::int16_t offset_minutes;
+    std::uint16_t year;
+    std::uint8_t month;
+    std::uint8_t day;
+    std::uint8_t hour;
+    std::uint8_t minute;
+    std::uint8_t second;
+    datetime_kind_t kind;
+
+    bool has_date() const {
+        return kind != datetime_kind_t::local_time;
+    }
+
+    bool has_time() const {
+        return kind != datetime_kind_t::local_date;
+    }
+
+    bool has_offset() const {
+        return kind == datetime_kind_t::offset_datetime;
+    }
+};
+
+
+inline bool operator==(const datetime_t &left, const datetime_t &right) {
+    return left.epoch_seconds == right.epoch_seconds &&
+           left.nanosecond == right.nanosecond &&
+           left.offset_minutes == right.offset_minutes &&
+           left.year == right.year &&
+           left.month == right.month &&
+           left.day == right.day &&
+           left.hour == right.hour &&
+           left.minute == right.minute &&
+           left.second == right.second &&
+           left.kind == right.kind;
+}
+
+inline bool operator!=(const datetime_t &left, const datetime_t &right) {
+    return !(left == right);
+}
+
+
+namespace detail {
+
+
+// Reads Count digits into value. All characters are read whatever they are, to keep the loop free of branches.
+template<std::size_t Count>
+inline bool read_digits(const char *data, unsigned &value) {
+    unsigned result = 0;
+    unsigned invalid = 0;
+
+    for (std::size_t i = 0; i < Count; ++i) {
+        // Characters below '0' wrap around to large values.
+        unsigned digit = static_cast<unsigned>(static_cast<unsigned char>(data[i])) - '0';
+        invalid |= (digit > 9);
+        result = result * 10 + digit;
+    }
+
+    value = result;
+    return invalid == 0;
+}
+
+
+inline unsigned days_in_month(unsigned year, unsigned month) {
+    static const unsigned char days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return days[month - 1] + ((month == 2 && leap) ? 1 : 0);
+}
+
+
+// Days since 1970-01-01 in the proleptic Gregorian calendar (http://howardhinnant.github.io/date_algorithms.html).
+inline std::int64_t days_from_civil(unsigned year, unsigned month, unsigned day) {
+    std::int64_t y = static_cast<std::int64_t>(year) - (month <= 2 ? 1 : 0);
+    std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    unsigned year_of_era = static_cast<unsigned>(y - era * 400);
+    unsigned day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + static_cast<std::int64_t>(day_of_era) - 719468;
+}
+
+
+} // namespace detail
+
+
+/*! Parse a TOML datetime.
+ *
+ * Accepts offset and local date-times, local dates and local times as defined by TOML, e.g. 1979-05-27T00:32:00.999-07:00.
+ * The date and the time must be separated by 'T' (or 't'), the whole text must be the datetime.
+ *
+ * \param[in] text The datetime.
+ * \param[out] value Parsed datetime, unspecified if the text isn't valid.
+ * \returns false if the text isn't a valid datetime.
+ */
+inline bool parse_datetime(string_ref_t text, datetime_t &value) {
+    const char *current = text.data();
+    const char *end = text.data() + text.size();
+
+    value = datetime_t();
+    std::int64_t days = 0;
+    bool has_date = text.size() < 3 || text[2] != ':';
+
+    if (has_date) {
+        unsigned year, month, day;
+
+        if (end - current < 10) {
+            return false;
+        }
+
+        // Non-short-circuit operators: the fixed layout is checked all at once.
+        bool valid = detail::read_digits<4>(current, year) &
+                     (current[4] == '-') &
+                     detail::read_digits<2>(current + 5, month) &
+                     (current[7] == '-') &
+                     detail::read_digits<2>(current + 8, day);
+
+        if (!valid || month < 1 || month > 12 || day < 1 || day > detail::days_in_month(year, month)) {
+            return false;
+        }
+
+        value.year = static_cast<std::uint16_t>(year);
+        value.month = static_cast<std::uint8_t>(month);
+        value.day = static_cast<std::uint8_t>(day);
+        days = detail::days_from_civil(year, month, day);
+        current += 10;
+
+        if (current == end) {
+            value.kind = datetime_kind_t::local_date;
+            value.epoch_seconds = days * 86400;
+            return true;
+        }
+
+        // 'T' | 0x20 == 't'.
+        if ((*current | 0x20) != 't') {
+            return false;
+        }
+
+        ++current;
+    }
+
+    unsigned hour, minute, second;
+
+    if (end - current < 8) {
+        return false;
+    }
+
+    bool valid = detail::read_digits<2>(current, hour) &
+                 (current[2] == ':') &
+                 detail::read_digits<2>(current + 3, minute) &
+                 (current[5] == ':') &
+                 detail::read_digits<2>(current + 6, second);
+
+    if (!valid || hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+
+    value.hour = static_cast<std::uint8_t>(hour);
+    value.minute = static_cast<std::uint8_t>(minute);
+    value.second = static_cast<std::uint8_t>(second);
+    current += 8;
+
+    if (current != end && *current == '.') {
+        const char *fraction = ++current;
+        std::uint32_t nanosecond = 0;
+
+        for (; current != end && *current >= '0' && *current <= '9'; ++current) {
+            if (current - fraction < 9) {
+                nanosecond = nanosecond * 10 + static_cast<std::uint32_t>(*current - '0');
+            }
+        }
+
+        if (current == fraction) {
+            return false;
+        }
+
+        for (std::ptrdiff_t digits = current - fraction; digits < 9; ++digits) {
+            nanosecond *= 10;
+        }
+
+        value.nanosecond = nanosecond;
+    }
+
+    std::int64_t seconds = hour * 3600 + minute * 60 + second;
+
+    if (!has_date) {
+        value.kind = datetime_kind_t::local_time;
+        value.epoch_seconds = seconds;
+        return current == end;
+    }
+
+    if (current == end) {
+        value.kind = datetime_kind_t::local_datetime;
+    } else if ((*current | 0x20) == 'z' && end - current == 1) {
+        value.kind = datetime_kind_t::offset_datetime;
+    } else if ((*current == '+' || *current == '-') && end - current == 6) {
+        unsigned offset_hour, offset_minute;
+
+        valid = detail::read_digits<2>(current + 1, offset_hour) &
+                (current[3] == ':') &
+                detail::read_digits<2>(current + 4, offset_minute);
+
+        if (!valid || offset_hour > 23 || offset_minute > 59) {
+            return false;
+        }
+
+        int offset = static_cast<int>(offset_hour * 60 + offset_minute);
+        value.offset_minutes = static_cast<std::int16_t>(*current == '-' ? -offset : offset);
+        value.kind = datetime_kind_t::offset_datetime;
+    } else {
+        return false;
+    }
+
+    value.epoch_seconds = days * 86400 + seconds - value.offset_minutes * 60;
+    return true;
+}
+
+
+//! Writes the datetime in the TOML format. The fraction of the second is written without trailing zeros.
+inline std::ostream &operator<<(std::ostream &output, const datetime_t &value) {
+    char buffer[40];
+    char *current = buffer;
+
+    auto write = [&current](unsigned number, int digits) {
+        for (int i = digits - 1; i >= 0; --i) {
+            current[i] = static_cast<char>('0' + number % 10);
+            number /= 10;
+        }
+
+        current += digits;
+    };
+
+    if (value.has_date()) {
+        write(value.year, 4);
+        *current++ = '-';
+        write(value.month, 2);
+        *current++ = '-';
+        write(value.day, 2);
+
+        if (value.has_time()) {
+            *current++ = 'T';
+        }
+    }
+
+    if (value.has_time()) {
+        write(value.hour, 2);
+        *current++ = ':';
+        write(value.minute, 2);
+        *current++ = ':';
+        write(value.second, 2);
+
+        if (value.nanosecond != 0) {
+            unsigned fraction = value.nanosecond;
+            int digits = 9;
+
+            for (; fraction % 10 == 0; fraction /= 10) {
+                --digits;
+            }
+
+            *current++ = '.';
+            write(fraction, digits);
+        }
+    }
+
+    if (value.has_offset()) {
+        if (value.offset_minutes == 0) {
+            *current++ = 'Z';
+        } else {
+            int offset = value.offset_minutes;
+            *current++ = (offset < 0) ? '-' : '+';
+            offset = (offset < 0) ? -offset : offset;
+            write(static_cast<unsigned>(offset / 60), 2);
+            *current++ = ':';
+            write(static_cast<unsigned>(offset % 60), 2);
+        }
+    }
+
+    return output.write(buffer, current - buffer);
+}
+
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DATETIME_HPP
@@ -0,0 +1,167 @@
+#ifndef LOLTOML_DETAIL_ARENA_HPP
+#define LOLTOML_DETAIL_ARENA_HPP
+
+#include "loltoml/detail/common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+/*
+ * Bump-pointer allocator. Memory is taken from blocks of growing size and is freed only all at once,
+ * by release() or the destructor, so objects created in the arena must be trivially destructible.
+ */
+class arena_t {
+public:
+    arena_t() :
+        m_blocks(nullptr),
+        m_current(nullptr),
+        m_end(nullptr),
+        m_next_block_size(initial_block_size),
+        m_allocated(0)
+    { }
+
+    ~arena_t() {
+        release();
+    }
+
+    arena_t(arena_t &&other) :
+        arena_t()
+    {
+        swap(other);
+    }
+
+    arena_t &operator=(arena_t &&other) {
+        if (this != &other) {
+            release();
+            swap(other);
+        }
+
+        return *this;
+    }
+
+    arena_t(const arena_t &) = delete;
+    arena_t &operator=(const arena_t &) = delete;
+
+    // Returns uninitialized memory, throws std::bad_alloc.
+    void *allocate(std::size_t size, std::size_t alignment) {
+        std::uintptr_t current = reinterpret_cast<std::uintptr_t>(m_current);
+        std::uintptr_t aligned = (current + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+
+        if (m_current == nullptr || aligned + size > reinterpret_cast<std::uintptr_t>(m_end)) {
+            add_block(size + alignment);
+            current = reinterpret_cast<std::uintptr_t>(m_current);
+            aligned = (current + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+        }
+
+        m_current = reinterpret_cast<char *>(aligned + size);
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    // Value-initializes a new object.
+    template<class T>
+    T *create() {
+        static_assert(std::is_trivially_destructible<T>::value, "Destructors of objects in the arena are never called");
+        return new (allocate(sizeof(T), alignof(T))) T();
+    }
+
+    // Uninitialized array of n objects.
+    template<class T>
+    T *create_array(std::size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value, "Destructors of objects in the arena are never called");
+        return static_cast<T *>(allocate(sizeof(T) * n, alignof(T)));
+    }
+
+    // Copies the characters into the arena. The copy isn't null-terminated.
+    const char *copy(const char *data, std::size_t size) {
+        if (size == 0) {
+            return "";
+        }
+
+        char *result = static_cast<char *>(allocate(size, 1));
+        std::memcpy(result, data, size);
+        return result;
+    }
+
+    // Frees all the memory at once.
+    void release() {
+        while (m_blocks) {
+            block_t *next = m_blocks->next;
+            std::free(m_blocks);
+            m_blocks = next;
+        }
+
+        m_current = nullptr;
+        m_end = nullptr;
+        m_next_block_size = initial_block_size;
+        m_allocated = 0;
+    }
+
+    // Total size of the blocks.
+    std::size_t allocated() const {
+        return m_allocated;
+    }
+
+    void swap(arena_t &other) {
+        std::swap(m_blocks, other.m_blocks);
+        std::swap(m_current, other.m_current);
+        std::swap(m_end, other.m_end);
+        std::swap(m_next_block_size, other.m_next_block_size);
+        std::swap(m_allocated, other.m_allocated);
+    }
+
+private:
+    static const std::size_t initial_block_size = 4096;
+    static const std::size_t max_block_size = 1 << 20;
+
+    struct block_t {
+        block_t *next;
+    };
+
+    void add_block(std::size_t min_size) {
+        std::size_t size = m_next_block_size;
+
+        while (size < min_size + sizeof(block_t)) {
+            size *= 2;
+        }
+
+        block_t *block = static_cast<block_t *>(std::malloc(size));
+
+        if (!block) {
+            throw std::bad_alloc();
+        }
+
+        block->next = m_blocks;
+        m_blocks = block;
+        m_current = reinterpret_cast<char *>(block + 1);
+        m_end = reinterpret_cast<char *>(block) + size;
+        m_allocated += size;
+
+        if (m_next_block_size < max_block_size) {
+            m_next_block_size *= 2;
+        }
+    }
+
+private:
+    block_t *m_blocks;
+    char *m_current;
+    char *m_end;
+    std::size_t m_next_block_size;
+    std::size_t m_allocated;
+};
+
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_ARENA_HPP
@@ -0,0 +1,285 @@
+#ifndef LOLTOML_DETAIL_CALLBACKS_HPP
+#define LOLTOML_DETAIL_CALLBACKS_HPP
+
+#include "loltoml/action.hpp"
+#include "loltoml/datetime.hpp"
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/handler_traits.hpp"
+#include "loltoml/key_interner.hpp"
+#include "loltoml/key_schema.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+typedef std::vector<std::string>::const_iterator key_iterator_t;
+
+
+// Thrown by callbacks_t when the handler returns action_t::stop, parsing functions catch it and finish the document.
+struct stop_parsing_t { };
+
+
+// Returns the action returned by a callback, or action_t::proceed if it returns anything else (e.g. void).
+template<class Result>
+struct callback_action {
+    template<class Call>
+    static action_t get(Call &&call) {
+        call();
+        return action_t::proceed;
+    }
+};
+
+template<>
+struct callback_action<action_t> {
+    template<class Call>
+    static action_t get(Call &&call) {
+        return call();
+    }
+};
+
+
+/*
+ * Defines has_<name>_callback<Handler, void(Args...)>, which is true if handler.name(args...) compiles,
+ * and call_<name>(has_callback, handler, args...), which calls the method only if it exists
+ * and returns the action requested by it.
+ */
+#define LOLTOML_DETAIL_OPTIONAL_CALLBACK(name)                                                     \
+    template<class Handler, class Signature, class = void>                                        \
+    struct has_##name##_callback : std::false_type { };                                           \
+                                                                                                  \
+    template<class Handler, class... Args>                                                        \
+    struct has_##name##_callback<                                                                 \
+        Handler,                                                                                  \
+        void(Args...),                                                                            \
+        typename always_void<decltype(std::declval<Handler &>().name(std::declval<Args>()...))>::type \
+    > : std::true_type { };                                                                       \
+                                                                                                  \
+    template<class Handler, class... Args>                                                        \
+    inline action_t call_##name(std::true_type, Handler &handler, Args &&... args) {              \
+        typedef decltype(handler.name(std::forward<Args>(args)...)) result_type;                  \
+        return callback_action<typename std::decay<result_type>::type>::get(                       \
+            [&]() -> result_type { return handler.name(std::forward<Args>(args)...); }            \
+        );                                                                                        \
+    }                                                                                             \
+                                                                                                  \
+    template<class Handler, class... Args>                                                        \
+    inline action_t call_##name(std::false_type, Handler &, Args &&...) {                          \
+        return action_t::proceed;                                                                 \
+    }
+
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(start_document)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(finish_document)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(comment)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(array_table)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(table)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(key)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(start_array)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(finish_array)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(start_inline_table)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(finish_inline_table)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(boolean)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(string)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(datetime)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(integer)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(floating_point)
+LOLTOML_DETAIL_OPTIONAL_CALLBACK(symbol)
+
+#undef LOLTOML_DETAIL_OPTIONAL_CALLBACK
+
+
+/*
+ * Calls the methods the handler has and silently ignores the rest.
+ * The has_* constants tell the parser which data it can skip building altogether.
+ * key(), table() and array_table() return the action requested by the handler, action_t::proceed by default.
+ * If any method returns action_t::stop, stop_parsing_t is thrown.
+ */
+template<class Handler>
+class callbacks_t {
+public:
+    typedef typename handler_string_type<Handler>::type string_type;
+
+    static const bool has_start_document = has_start_document_callback<Handler, void()>::value;
+    static const bool has_finish_document = has_finish_document_callback<Handler, void()>::value;
+    static const bool has_comment = has_comment_callback<Handler, void(string_type)>::value;
+    static const bool has_array_table = has_array_table_callback<Handler, void(key_iterator_t, key_iterator_t)>::value;
+    static const bool has_table = has_table_callback<Handler, void(key_iterator_t, key_iterator_t)>::value;
+    static const bool has_key = has_key_callback<Handler, void(string_type)>::value;
+    static const bool has_interned_key = has_key_callback<Handler, void(interned_key_t)>::value;
+    static const bool has_schema_key = has_key_callback<Handler, void(schema_key_t)>::value;
+    static const bool has_start_array = has_start_array_callback<Handler, void()>::value;
+    static const bool has_finish_array = has_finish_array_callback<Handler, void(std::size_t)>::value;
+    static const bool has_start_inline_table = has_start_inline_table_callback<Handler, void()>::value;
+    static const bool has_finish_inline_table = has_finish_inline_table_callback<Handler, void(std::size_t)>::value;
+    static const bool has_boolean = has_boolean_callback<Handler, void(bool)>::value;
+    static const bool has_string = has_string_callback<Handler, void(string_type)>::value;
+    // Datetimes are passed as datetime_t, datetime_t and text, or text only, whichever the handler has first.
+    static const bool has_datetime = has_datetime_callback<Handler, void(string_type)>::value;
+    static const bool has_datetime_value = has_datetime_callback<Handler, void(datetime_t)>::value;
+    static const bool has_datetime_value_and_text = has_datetime_callback<Handler, void(datetime_t, string_type)>::value;
+    static const bool has_datetime_text = has_datetime_value_and_text || (has_datetime && !has_datetime_value);
+    static const bool has_integer = has_integer_callback<Handler, void(std::int64_t)>::value;
+    static const bool has_floating_point = has_floating_point_callback<Handler, void(double)>::value;
+    static const bool has_symbol = has_symbol_callback<Handler, void(string_type)>::value;
+
+    // True if contents of tokens are never passed to the handler.
+    static const bool discards_tokens =
+        !has_comment && !has_array_table && !has_table && !has_key && !has_string && !has_symbol && !has_datetime_text;
+
+    explicit callbacks_t(Handler &handler) :
+        m_handler(handler)
+    { }
+
+    void start_document() {
+        check(call_start_document(std::integral_constant<bool, has_start_document>(), m_handler));
+    }
+
+    void finish_document() {
+        // The document is over anyway, so there is nothing to stop.
+        call_finish_document(std::integral_constant<bool, has_finish_document>(), m_handler);
+    }
+
+    void comment(const string_type &value) {
+        check(call_comment(std::integral_constant<bool, has_comment>(), m_handler, value));
+    }
+
+    action_t array_table(key_iterator_t begin, key_iterator_t end) {
+        return check(call_array_table(std::integral_constant<bool, has_array_table>(), m_handler, begin, end));
+    }
+
+    action_t table(key_iterator_t begin, key_iterator_t end) {
+        return check(call_table(std::integral_constant<bool, has_table>(), m_handler, begin, end));
+    }
+
+    action_t key(const string_type &value) {
+        return check(call_key(std::integral_constant<bool, has_key>(), m_handler, value));
+    }
+
+    action_t key(const interned_key_t &value) {
+        return check(call_key(std::integral_constant<bool, has_interned_key>(), m_handler, value));
+    }
+
+    action_t key(const schema_key_t &value) {
+        return check(call_key(std::integral_constant<bool, has_schema_key>(), m_handler, value));
+    }
+
+    void start_array() {
+        check(call_start_array(std::integral_constant<bool, has_start_array>(), m_handler));
+    }
+
+    void finish_array(std::size_t size) {
+        check(call_finish_array(std::integral_constant<bool, has_finish_array>(), m_handler, size));
+    }
+
+    void start_inline_table() {
+        check(call_start_inline_table(std::integral_constant<bool, has_start_inline_table>(), m_handler));
+    }
+
+    void finish_inline_table(std::size_t size) {
+        check(call_finish_inline_table(std::integral_constant<bool, has_finish_inline_table>(), m_handler, size));
+    }
+
+    void boolean(bool value) {
+        check(call_boolean(std::integral_constant<bool, has_boolean>(), m_handler, value));
+    }
+
+    void string(const string_type &value) {
+        check(call_string(std::integral_constant<bool, has_string>(), m_handler, value));
+    }
+
+    void datetime(const datetime_t &value) {
+        check(call_datetime(std::integral_constant<bool, has_datetime_value>(), m_handler, value));
+    }
+
+    // Used instead of datetime(value) if has_datetime_text.
+    void datetime(const datetime_t &value, const string_type &text) {
+        if (has_datetime_value_and_text) {
+            check(call_datetime(std::integral_constant<bool, has_datetime_value_and_text>(), m_handler, value, text));
+        } else {
+            check(call_datetime(std::integral_constant<bool, has_datetime>(), m_handler, text));
+        }
+    }
+
+    void integer(std::int64_t value) {
+        check(call_integer(std::integral_constant<bool, has_integer>(), m_handler, value));
+    }
+
+    void floating_point(double value) {
+        check(call_floating_point(std::integral_constant<bool, has_floating_point>(), m_handler, value));
+    }
+
+    void symbol(const string_type &value) {
+        check(call_symbol(std::integral_constant<bool, has_symbol>(), m_handler, value));
+    }
+
+private:
+    static action_t check(action_t action) {
+        if (action == action_t::stop) {
+            throw stop_parsing_t();
+        }
+
+        return action;
+    }
+
+private:
+    Handler &m_handler;
+};
+
+template<class Handler>
+const bool callbacks_t<Handler>::has_start_document;
+template<class Handler>
+const bool callbacks_t<Handler>::has_finish_document;
+template<class Handler>
+const bool callbacks_t<Handler>::has_comment;
+template<class Handler>
+const bool callbacks_t<Handler>::has_array_table;
+template<class Handler>
+const bool callbacks_t<Handler>::has_table;
+template<class Handler>
+const bool callbacks_t<Handler>::has_key;
+template<class Handler>
+const bool callbacks_t<Handler>::has_interned_key;
+template<class Handler>
+const bool callbacks_t<Handler>::has_schema_key;
+template<class Handler>
+const bool callbacks_t<Handler>::has_start_array;
+template<class Handler>
+const bool callbacks_t<Handler>::has_finish_array;
+template<class Handler>
+const bool callbacks_t<Handler>::has_start_inline_table;
+template<class Handler>
+const bool callbacks_t<Handler>::has_finish_inline_table;
+template<class Handler>
+const bool callbacks_t<Handler>::has_boolean;
+template<class Handler>
+const bool callbacks_t<Handler>::has_string;
+template<class Handler>
+const bool callbacks_t<Handler>::has_datetime;
+template<class Handler>
+const bool callbacks_t<Handler>::has_datetime_value;
+template<class Handler>
+const bool callbacks_t<Handler>::has_datetime_value_and_text;
+template<class Handler>
+const bool callbacks_t<Handler>::has_datetime_text;
+template<class Handler>
+const bool callbacks_t<Handler>::has_integer;
+template<class Handler>
+const bool callbacks_t<Handler>::has_floating_point;
+template<class Handler>
+const bool callbacks_t<Handler>::has_symbol;
+template<class Handler>
+const bool callbacks_t<Handler>::discards_tokens;
+
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_CALLBACKS_HPP
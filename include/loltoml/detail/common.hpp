@@ -10,4 +10,13 @@
 #define LOLTOML_OPEN_NAMESPACE namespace loltoml { inline namespace LOLTOML_VERSION_NAMESPACE {
 #define LOLTOML_CLOSE_NAMESPACE }}
 
+// For optional features called from the parser: inlined, they make the hot functions too big to be inlined themselves.
+#if defined(__GNUC__) || defined(__clang__)
+#define LOLTOML_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define LOLTOML_NOINLINE __declspec(noinline)
+#else
+#define LOLTOML_NOINLINE
+#endif
+
 #endif // LOLTOML_DETAIL_COMMON_HPP
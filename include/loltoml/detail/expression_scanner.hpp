@@ -0,0 +1,180 @@
+#ifndef LOLTOML_DETAIL_EXPRESSION_SCANNER_HPP
+#define LOLTOML_DETAIL_EXPRESSION_SCANNER_HPP
+
+#include "loltoml/detail/common.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+/*
+ * Finds ends of top-level expressions (key-value pairs, table headers, comments) in a document which arrives in pieces.
+ * An expression ends with a new-line which is not inside a string, a comment or an array.
+ * It doesn't validate anything: in invalid documents it just finds some boundaries, and the parser reports the errors.
+ */
+class expression_scanner_t {
+public:
+    struct result_t {
+        // Past the new-line ending an expression if complete is true.
+        // Otherwise scanning stopped there because more data is needed, and it must be resumed from this position.
+        const char *position;
+        bool complete;
+    };
+
+    expression_scanner_t() {
+        reset();
+    }
+
+    // Scans [begin, end) which continues the data scanned before (or starts a new expression after a complete one).
+    result_t scan(const char *begin, const char *end) {
+        const char *current = begin;
+
+        while (current != end) {
+            char ch = *current;
+
+            switch (m_state) {
+                case state_t::normal: {
+                    if (ch == '\n') {
+                        ++current;
+
+                        if (m_depth == 0) {
+                            reset();
+                            return result_t {current, true};
+                        }
+
+                        continue;
+                    } else if (ch == '#') {
+                        m_state = state_t::comment;
+                    } else if (ch == '=' && m_depth == 0) {
+                        m_in_value = true;
+                    } else if (ch == '[' && m_in_value) {
+                        // Arrays may span multiple lines, table headers may not.
+                        ++m_depth;
+                    } else if (ch == ']' && m_depth > 0) {
+                        --m_depth;
+                    } else if (ch == '"' || ch == '\'') {
+                        // Three characters are needed to tell a multi-line string from a basic one.
+                        if (end - current < 3) {
+                            return result_t {current, false};
+                        }
+
+                        if (current[1] == ch && current[2] == ch) {
+                            m_state = (ch == '"') ? state_t::multiline_basic_string : state_t::multiline_literal_string;
+                            current += 3;
+                        } else if (current[1] == ch) {
+                            // Empty string.
+                            current += 2;
+                        } else {
+                            m_state = (ch == '"') ? state_t::basic_string : state_t::literal_string;
+                            current += 1;
+                        }
+
+                        continue;
+                    }
+
+                    ++current;
+                } break;
+
+                case state_t::comment: {
+                    const char *new_line = static_cast<const char *>(std::memchr(current, '\n', end - current));
+
+                    if (!new_line) {
+                        return result_t {end, false};
+                    }
+
+                    // The new-line itself is processed in the normal state.
+                    m_state = state_t::normal;
+                    current = new_line;
+                } break;
+
+                case state_t::basic_string:
+                case state_t::multiline_basic_string: {
+                    bool multiline = (m_state == state_t::multiline_basic_string);
+
+                    if (ch == '\\') {
+                        if (end - current < 2) {
+                            return result_t {current, false};
+                        }
+
+                        current += 2;
+                        continue;
+                    } else if (ch == '"') {
+                        if (!multiline) {
+                            m_state = state_t::normal;
+                        } else if (end - current < 3) {
+                            return result_t {current, false};
+                        } else if (current[1] == '"' && current[2] == '"') {
+                            m_state = state_t::normal;
+                            current += 3;
+                            continue;
+                        }
+                    } else if (ch == '\n' && !multiline) {
+                        // Invalid, but let the parser report it on this line.
+                        m_state = state_t::normal;
+                        continue;
+                    }
+
+                    ++current;
+                } break;
+
+                case state_t::literal_string:
+                case state_t::multiline_literal_string: {
+                    bool multiline = (m_state == state_t::multiline_literal_string);
+
+                    if (ch == '\'') {
+                        if (!multiline) {
+                            m_state = state_t::normal;
+                        } else if (end - current < 3) {
+                            return result_t {current, false};
+                        } else if (current[1] == '\'' && current[2] == '\'') {
+                            m_state = state_t::normal;
+                            current += 3;
+                            continue;
+                        }
+                    } else if (ch == '\n' && !multiline) {
+                        m_state = state_t::normal;
+                        continue;
+                    }
+
+                    ++current;
+                } break;
+            }
+        }
+
+        return result_t {end, false};
+    }
+
+private:
+    enum class state_t {
+        normal,
+        comment,
+        basic_string,
+        multiline_basic_string,
+        literal_string,
+        multiline_literal_string
+    };
+
+    void reset() {
+        m_state = state_t::normal;
+        m_depth = 0;
+        m_in_value = false;
+    }
+
+private:
+    state_t m_state;
+    // Nesting level of arrays.
+    std::size_t m_depth;
+    // True after '=' of a top-level key-value pair.
+    bool m_in_value;
+};
+
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_EXPRESSION_SCANNER_HPP
@@ -0,0 +1,286 @@
+#ifndef LOLTOML_DETAIL_FLOAT_CONVERSION_HPP
+#define LOLTOML_DETAIL_FLOAT_CONVERSION_HPP
+
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/power_of_five.hpp"
+
+#include <cfloat>
+#include <clocale>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+/*
+ * Decimal number accumulated by the parser digit by digit: value = significand * 10^exponent.
+ * Only the first 19 significant digits are kept, the rest just adjust the exponent.
+ */
+struct decimal_t {
+    static const int max_digits = 19;
+
+    decimal_t() :
+        significand(0),
+        digits(0),
+        exponent(0),
+        truncated(false)
+    { }
+
+    void append(unsigned int digit, bool fractional) {
+        if (digits == 0 && digit == 0) {
+            // Leading zeros are not significant.
+            if (fractional) {
+                --exponent;
+            }
+        } else if (digits < max_digits) {
+            significand = significand * 10 + digit;
+            ++digits;
+
+            if (fractional) {
+                --exponent;
+            }
+        } else {
+            if (!fractional) {
+                ++exponent;
+            }
+
+            if (digit != 0) {
+                truncated = true;
+            }
+        }
+    }
+
+    std::uint64_t significand;
+    int digits;
+    std::int64_t exponent;
+    // True if some non-zero digits were dropped, i.e. the real significand is a bit larger.
+    bool truncated;
+};
+
+
+namespace float_conversion {
+
+
+struct uint128_t {
+    std::uint64_t low;
+    std::uint64_t high;
+};
+
+inline uint128_t multiply(std::uint64_t a, std::uint64_t b) {
+    uint128_t result;
+
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 native_uint128_t;
+    native_uint128_t product = static_cast<native_uint128_t>(a) * b;
+    result.low = static_cast<std::uint64_t>(product);
+    result.high = static_cast<std::uint64_t>(product >> 64);
+#else
+    std::uint64_t a_low = a & 0xFFFFFFFF;
+    std::uint64_t a_high = a >> 32;
+    std::uint64_t b_low = b & 0xFFFFFFFF;
+    std::uint64_t b_high = b >> 32;
+
+    std::uint64_t low_low = a_low * b_low;
+    std::uint64_t high_low = a_high * b_low;
+    std::uint64_t low_high = a_low * b_high;
+    std::uint64_t high_high = a_high * b_high;
+
+    std::uint64_t cross = (low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high;
+    result.low = (cross << 32) | (low_low & 0xFFFFFFFF);
+    result.high = (high_low >> 32) + (cross >> 32) + high_high;
+#endif
+
+    return result;
+}
+
+inline int count_leading_zeros(std::uint64_t value) {
+#if defined(__GNUC__)
+    return __builtin_clzll(value);
+#else
+    int count = 0;
+
+    while ((value & (std::uint64_t(1) << 63)) == 0) {
+        value <<= 1;
+        ++count;
+    }
+
+    return count;
+#endif
+}
+
+inline double make_double(std::uint64_t mantissa, std::int64_t biased_exponent, bool negative) {
+    std::uint64_t bits = mantissa | (static_cast<std::uint64_t>(biased_exponent) << 52) | (std::uint64_t(negative) << 63);
+    double result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+
+const int mantissa_bits = 52;
+const int minimum_exponent = -1023;
+const int infinite_exponent = 0x7FF;
+
+/*
+ * Clinger's fast path: both the significand and the power of ten are exact doubles,
+ * so a single correctly rounded operation gives the correctly rounded result.
+ * It's valid only if doubles are evaluated with their own precision (not with x87 80-bit registers).
+ */
+inline bool clinger(std::uint64_t significand, std::int64_t exponent, bool negative, double *result) {
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    static const double powers_of_ten[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    if (significand > (std::uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+        return false;
+    }
+
+    double value = static_cast<double>(significand);
+
+    if (exponent < 0) {
+        value /= powers_of_ten[-exponent];
+    } else {
+        value *= powers_of_ten[exponent];
+    }
+
+    *result = negative ? -value : value;
+    return true;
+#else
+    (void)significand;
+    (void)exponent;
+    (void)negative;
+    (void)result;
+    return false;
+#endif
+}
+
+/*
+ * Eisel-Lemire algorithm, see "Number Parsing at a Gigabyte per Second" by Daniel Lemire
+ * and "Fast Number Parsing Without Fallback" by Noble Mushtak and Daniel Lemire.
+ * Multiplies the significand by a 128-bit approximation of 5^exponent; the result is exact enough
+ * to determine the correctly rounded double for any significand of up to 19 digits.
+ */
+inline double eisel_lemire(std::uint64_t significand, std::int64_t exponent, bool negative) {
+    if (significand == 0 || exponent < smallest_power_of_five) {
+        return make_double(0, 0, negative);
+    } else if (exponent > largest_power_of_five) {
+        return make_double(0, infinite_exponent, negative);
+    }
+
+    int leading_zeros = count_leading_zeros(significand);
+    significand <<= leading_zeros;
+
+    // 55 bits of the product are enough: the mantissa, the hidden bit, the rounding bit and one more bit to detect overflow.
+    const std::uint64_t *power = &power_of_five_table_t<>::values[2 * (exponent - smallest_power_of_five)];
+    uint128_t product = multiply(significand, power[0]);
+    const std::uint64_t precision_mask = std::numeric_limits<std::uint64_t>::max() >> (mantissa_bits + 3);
+
+    if ((product.high & precision_mask) == precision_mask) {
+        // The lower bits may be affected by the truncated part of the power, so take it into account.
+        uint128_t correction = multiply(significand, power[1]);
+        product.low += correction.high;
+
+        if (correction.high > product.low) {
+            ++product.high;
+        }
+    }
+
+    int upper_bit = static_cast<int>(product.high >> 63);
+    int shift = upper_bit + 64 - mantissa_bits - 3;
+    std::uint64_t mantissa = product.high >> shift;
+
+    // floor(log2(10^exponent)) + 63 == ((217706 * exponent) >> 16) + 63 for the supported range.
+    std::int64_t biased_exponent = ((217706 * exponent) >> 16) + 63 + upper_bit - leading_zeros - minimum_exponent;
+
+    if (biased_exponent <= 0) {
+        // Subnormal number or zero.
+        if (-biased_exponent + 1 >= 64) {
+            return make_double(0, 0, negative);
+        }
+
+        mantissa >>= -biased_exponent + 1;
+        mantissa += (mantissa & 1);
+        mantissa >>= 1;
+
+        // Rounding may turn the largest subnormal number into the smallest normal one.
+        biased_exponent = (mantissa < (std::uint64_t(1) << mantissa_bits)) ? 0 : 1;
+        return make_double(mantissa & ~(std::uint64_t(1) << mantissa_bits), biased_exponent, negative);
+    }
+
+    // The product can be exactly in the middle between two doubles only for small exponents;
+    // round-half-to-even then.
+    if (product.low <= 1 && exponent >= -4 && exponent <= 23 && (mantissa & 3) == 1 &&
+        (mantissa << shift) == product.high)
+    {
+        mantissa &= ~std::uint64_t(1);
+    }
+
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+
+    if (mantissa >= (std::uint64_t(2) << mantissa_bits)) {
+        mantissa = std::uint64_t(1) << mantissa_bits;
+        ++biased_exponent;
+    }
+
+    if (biased_exponent >= infinite_exponent) {
+        return make_double(0, infinite_exponent, negative);
+    }
+
+    return make_double(mantissa & ~(std::uint64_t(1) << mantissa_bits), biased_exponent, negative);
+}
+
+
+} // namespace float_conversion
+
+
+/*
+ * Converts the decimal to the nearest double.
+ * Returns false if the decimal was truncated and the dropped digits may affect rounding;
+ * the caller must then convert the full text with strtod_c_locale().
+ */
+inline bool decimal_to_double(const decimal_t &decimal, bool negative, double *result) {
+    if (!decimal.truncated && float_conversion::clinger(decimal.significand, decimal.exponent, negative, result)) {
+        return true;
+    }
+
+    double value = float_conversion::eisel_lemire(decimal.significand, decimal.exponent, negative);
+
+    if (decimal.truncated) {
+        // The real value is between significand and significand + 1.
+        double upper = float_conversion::eisel_lemire(decimal.significand + 1, decimal.exponent, negative);
+
+        if (value != upper) {
+            return false;
+        }
+    }
+
+    *result = value;
+    return true;
+}
+
+
+// std::strtod() which always expects '.' as the decimal point, whatever the current C locale is.
+inline double strtod_c_locale(std::string text) {
+    const char *decimal_point = std::localeconv()->decimal_point;
+    std::string::size_type position = text.find('.');
+
+    if (position != std::string::npos && std::strcmp(decimal_point, ".") != 0) {
+        text.replace(position, 1, decimal_point);
+    }
+
+    return std::strtod(text.c_str(), nullptr);
+}
+
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_FLOAT_CONVERSION_HPP
@@ -0,0 +1,35 @@
+#ifndef LOLTOML_DETAIL_HANDLER_TRAITS_HPP
+#define LOLTOML_DETAIL_HANDLER_TRAITS_HPP
+
+#include "loltoml/detail/common.hpp"
+
+#include <string>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+template<class T>
+struct always_void {
+    typedef void type;
+};
+
+
+// Handler::string_type if it's declared, std::string otherwise.
+template<class Handler, class = void>
+struct handler_string_type {
+    typedef std::string type;
+};
+
+template<class Handler>
+struct handler_string_type<Handler, typename always_void<typename Handler::string_type>::type> {
+    typedef typename Handler::string_type type;
+};
+
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_HANDLER_TRAITS_HPP
@@ -0,0 +1,51 @@
+#ifndef LOLTOML_DETAIL_HASH_HPP
+#define LOLTOML_DETAIL_HASH_HPP
+
+#include "loltoml/detail/common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+// FNV-1a hash of no bytes.
+const std::uint64_t hash_basis = 14695981039346656037ULL;
+
+
+// FNV-1a continuing from the hash of the preceding bytes, so that a key path can be hashed key by key.
+inline std::uint64_t hash_append(std::uint64_t hash, const char *data, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+
+// FNV-1a. Keys are short, so it's hard to beat on them.
+inline std::size_t hash_bytes(const char *data, std::size_t size) {
+    return static_cast<std::size_t>(hash_append(hash_basis, data, size));
+}
+
+
+// hash_bytes() of a null-terminated string, usable in constant expressions.
+constexpr std::size_t hash_string(const char *data, std::uint64_t hash = hash_basis) {
+    return *data ? hash_string(data + 1, (hash ^ static_cast<unsigned char>(*data)) * 1099511628211ULL)
+                 : static_cast<std::size_t>(hash);
+}
+
+
+// Mixes all bits of an integer into the high ones, the hash tables take them by shifting.
+inline std::uint64_t hash_integer(std::uint64_t value) {
+    return value * 0x9E3779B97F4A7C15ULL;
+}
+
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_HASH_HPP
@@ -0,0 +1,146 @@
+#ifndef LOLTOML_DETAIL_INPUT_BUFFER_HPP
+#define LOLTOML_DETAIL_INPUT_BUFFER_HPP
+
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/simd.hpp"
+#include "loltoml/detail/token.hpp"
+#include "loltoml/error.hpp"
+
+#include <cstddef>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+// Same interface and EOF semantics as input_stream_t, but reads from a contiguous memory buffer.
+class input_buffer_t {
+public:
+    input_buffer_t(const char *begin, const char *end) :
+        m_begin(begin),
+        m_current(begin),
+        m_end(end),
+        m_eof(false),
+        m_emit_eol(true)
+    { }
+
+    char peek() {
+        if (m_current != m_end) {
+            return *m_current;
+        }
+
+        m_eof = true;
+
+        if (m_emit_eol) {
+            return '\n';
+        } else {
+            throw parser_error_t("Unexpected EOF", processed());
+        }
+    }
+
+    char get() {
+        if (m_current != m_end) {
+            return *m_current++;
+        }
+
+        m_eof = true;
+
+        if (m_emit_eol) {
+            m_emit_eol = false;
+            return '\n';
+        } else {
+            throw parser_error_t("Unexpected EOF", processed());
+        }
+    }
+
+    // Like std::istream::eof(), it becomes true only after an attempt to read past the end.
+    bool eof() const {
+        return m_eof;
+    }
+
+    std::size_t processed() const {
+        return static_cast<std::size_t>(m_current - m_begin);
+    }
+
+    // Skips spaces and tabs.
+    void skip_spaces() {
+        advance_to(simd::skip<simd::blank_class_t>(m_current, m_end));
+    }
+
+    // Skips spaces, tabs and new-lines (but not "\r\n").
+    void skip_whitespace() {
+        advance_to(simd::skip<simd::whitespace_class_t>(m_current, m_end));
+    }
+
+    // Appends characters allowed in a comment to the token.
+    void read_comment(token_t &token) {
+        read_run<simd::comment_class_t>(token);
+    }
+
+    // Appends characters which can be copied from a basic string as is to the token.
+    void read_basic_string_run(token_t &token) {
+        read_run<simd::basic_string_class_t>(token);
+    }
+
+    // Appends characters which can be copied from a literal string as is to the token.
+    void read_literal_string_run(token_t &token) {
+        read_run<simd::literal_string_class_t>(token);
+    }
+
+    // Skips characters allowed in a comment.
+    void skip_comment() {
+        advance_to(simd::skip<simd::comment_class_t>(m_current, m_end));
+    }
+
+    // Skips characters which can be copied from a basic string as is.
+    void skip_basic_string_run() {
+        advance_to(simd::skip<simd::basic_string_class_t>(m_current, m_end));
+    }
+
+    // Skips characters which can be copied from a literal string as is.
+    void skip_literal_string_run() {
+        advance_to(simd::skip<simd::literal_string_class_t>(m_current, m_end));
+    }
+
+    // Skips characters which don't affect the structure of skipped values.
+    void skip_unstructured_run() {
+        advance_to(simd::skip<simd::unstructured_class_t>(m_current, m_end));
+    }
+
+    // Pointer to the next character. Tokens may refer to the buffer instead of copying it.
+    const char *position() const {
+        return m_current;
+    }
+
+private:
+    template<class Class>
+    void read_run(token_t &token) {
+        const char *run_end = simd::skip<Class>(m_current, m_end);
+        token.append_source(m_current, static_cast<std::size_t>(run_end - m_current));
+        advance_to(run_end);
+    }
+
+    // Moves to the given position as if the characters were read one by one.
+    void advance_to(const char *position) {
+        m_current = position;
+
+        // The scalar loops peek() past the last character and set EOF.
+        if (m_current == m_end) {
+            m_eof = true;
+        }
+    }
+
+private:
+    const char *m_begin;
+    const char *m_current;
+    const char *m_end;
+    bool m_eof;
+    bool m_emit_eol;
+};
+
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_INPUT_BUFFER_HPP
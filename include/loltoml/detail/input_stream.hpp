@@ -2,6 +2,8 @@
 #define LOLTOML_DETAIL_INPUT_STREAM_HPP
 
 #include "loltoml/detail/common.hpp"
+#include "loltoml/detail/simd.hpp"
+#include "loltoml/detail/token.hpp"
 #include "loltoml/error.hpp"
 
 #include <iostream>
@@ -62,6 +64,74 @@ public:
         return m_processed;
     }
 
+    // Skips spaces and tabs.
+    void skip_spaces() {
+        while (!eof() && (peek() == ' ' || peek() == '\t')) {
+            get();
+        }
+    }
+
+    // Skips spaces, tabs and new-lines (but not "\r\n").
+    void skip_whitespace() {
+        while (!eof() && (peek() == ' ' || peek() == '\t' || peek() == '\n')) {
+            get();
+        }
+    }
+
+    // Appends characters allowed in a comment to the token.
+    void read_comment(token_t &token) {
+        while (simd::comment_class_t::contains(peek())) {
+            token.append_source(get());
+        }
+    }
+
+    // Appends characters which can be copied from a basic string as is to the token.
+    void read_basic_string_run(token_t &token) {
+        while (simd::basic_string_class_t::contains(peek())) {
+            token.append_source(get());
+        }
+    }
+
+    // Appends characters which can be copied from a literal string as is to the token.
+    void read_literal_string_run(token_t &token) {
+        while (simd::literal_string_class_t::contains(peek())) {
+            token.append_source(get());
+        }
+    }
+
+    // Skips characters allowed in a comment.
+    void skip_comment() {
+        while (simd::comment_class_t::contains(peek())) {
+            get();
+        }
+    }
+
+    // Skips characters which can be copied from a basic string as is.
+    void skip_basic_string_run() {
+        while (simd::basic_string_class_t::contains(peek())) {
+            get();
+        }
+    }
+
+    // Skips characters which can be copied from a literal string as is.
+    void skip_literal_string_run() {
+        while (simd::literal_string_class_t::contains(peek())) {
+            get();
+        }
+    }
+
+    // Skips characters which don't affect the structure of skipped values.
+    void skip_unstructured_run() {
+        while (!eof() && simd::unstructured_class_t::contains(peek())) {
+            get();
+        }
+    }
+
+    // Characters of a stream aren't kept in memory, so tokens always copy them.
+    const char *position() const {
+        return nullptr;
+    }
+
 private:
     std::istream &m_backend;
     std::size_t m_processed;
@@ -0,0 +1,241 @@
+#ifndef LOLTOML_DETAIL_KEY_CHECKER_HPP
+#define LOLTOML_DETAIL_KEY_CHECKER_HPP
+
+#include "loltoml/detail/callbacks.hpp"
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/hash.hpp"
+#include "loltoml/key_interner.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+/*
+ * Detects keys and tables defined twice (see parse_options_t::check_duplicate_keys).
+ *
+ * Every table, key and inline table of the document is a node of a trie, the root table is node 0.
+ * Edges are kept in a single open-addressing hash table keyed by (parent node, interned key id),
+ * so each key costs one lookup of its bytes in the interner and one integer lookup,
+ * whatever the depth of the table.
+ *
+ * Methods returning const char * return nullptr if the event is fine and a message describing the error otherwise.
+ * They aren't inlined to keep the parser fast when the checker is off.
+ */
+class key_checker_t {
+public:
+    key_checker_t() :
+        m_edges(16),
+        m_edges_count(0),
+        m_pending(0)
+    {
+        node_t root = { node_kind_t::defined_table, 0 };
+        m_nodes.push_back(root);
+        m_stack.push_back(0);
+    }
+
+    LOLTOML_NOINLINE const char *table(key_iterator_t begin, key_iterator_t end) {
+        std::uint32_t parent;
+
+        if (const char *error = open_parent(begin, end, parent)) {
+            return error;
+        }
+
+        std::uint32_t id = m_interner.intern(*(end - 1)).id;
+        std::uint32_t node = find(parent, id);
+
+        if (node == 0) {
+            node = add(parent, id, node_kind_t::defined_table);
+        } else if (m_nodes[node].kind == node_kind_t::implicit_table) {
+            m_nodes[node].kind = node_kind_t::defined_table;
+        } else {
+            return "Table is defined twice";
+        }
+
+        m_stack.assign(1, node);
+        return nullptr;
+    }
+
+    LOLTOML_NOINLINE const char *array_table(key_iterator_t begin, key_iterator_t end) {
+        std::uint32_t parent;
+
+        if (const char *error = open_parent(begin, end, parent)) {
+            return error;
+        }
+
+        std::uint32_t id = m_interner.intern(*(end - 1)).id;
+        std::uint32_t node = find(parent, id);
+
+        if (node == 0) {
+            node = add(parent, id, node_kind_t::table_array);
+        } else if (m_nodes[node].kind != node_kind_t::table_array) {
+            return "Key is already defined and isn't an array of tables";
+        }
+
+        std::uint32_t element = new_node(node_kind_t::defined_table);
+        m_nodes[node].last_element = element;
+        m_stack.assign(1, element);
+        return nullptr;
+    }
+
+    LOLTOML_NOINLINE const char *key(const char *data, std::size_t size) {
+        std::uint32_t parent = m_stack.back();
+        std::uint32_t id = m_interner.intern(string_ref_t(data, size)).id;
+
+        if (find(parent, id) != 0) {
+            return "Key is defined twice";
+        }
+
+        m_pending = add(parent, id, node_kind_t::value);
+        return nullptr;
+    }
+
+    // Keys of an inline table are children of its key, keys of inline tables inside arrays belong to anonymous nodes.
+    LOLTOML_NOINLINE void start_inline_table() {
+        if (m_stack.back() == array_context) {
+            m_stack.push_back(new_node(node_kind_t::value));
+        } else {
+            m_stack.push_back(m_pending);
+        }
+    }
+
+    LOLTOML_NOINLINE void finish_inline_table() {
+        m_stack.pop_back();
+    }
+
+    LOLTOML_NOINLINE void start_array() {
+        m_stack.push_back(array_context);
+    }
+
+    LOLTOML_NOINLINE void finish_array() {
+        m_stack.pop_back();
+    }
+
+private:
+    enum class node_kind_t : std::uint8_t {
+        // Created by a header like [a.b] for a, may be defined later by [a].
+        implicit_table,
+        defined_table,
+        // Created by [[a]], headers through it lead to its last element.
+        table_array,
+        // Any value of a key-value pair including inline tables and arrays. It can't be extended by headers.
+        value
+    };
+
+    struct node_t {
+        node_kind_t kind;
+        std::uint32_t last_element;
+    };
+
+    struct edge_t {
+        // Parent node in the high half, key id in the low one.
+        std::uint64_t key;
+        // 0 for empty slots, because the root is nobody's child.
+        std::uint32_t child;
+    };
+
+    // Marks arrays on the stack.
+    enum : std::uint32_t { array_context = 0xFFFFFFFF };
+
+    static std::uint64_t edge_key(std::uint32_t parent, std::uint32_t id) {
+        return (static_cast<std::uint64_t>(parent) << 32) | id;
+    }
+
+    std::size_t slot(std::uint64_t key) const {
+        // The table size is a power of two, so the high bits of the hash are taken.
+        return static_cast<std::size_t>(hash_integer(key) >> 32) & (m_edges.size() - 1);
+    }
+
+    std::uint32_t find(std::uint32_t parent, std::uint32_t id) const {
+        std::uint64_t key = edge_key(parent, id);
+        std::size_t mask = m_edges.size() - 1;
+
+        for (std::size_t i = slot(key); m_edges[i].child != 0; i = (i + 1) & mask) {
+            if (m_edges[i].key == key) {
+                return m_edges[i].child;
+            }
+        }
+
+        return 0;
+    }
+
+    std::uint32_t new_node(node_kind_t kind) {
+        node_t node = { kind, 0 };
+        m_nodes.push_back(node);
+        return static_cast<std::uint32_t>(m_nodes.size() - 1);
+    }
+
+    std::uint32_t add(std::uint32_t parent, std::uint32_t id, node_kind_t kind) {
+        std::uint32_t child = new_node(kind);
+
+        if (++m_edges_count * 2 > m_edges.size()) {
+            std::vector<edge_t> edges(m_edges.size() * 2);
+            edges.swap(m_edges);
+
+            for (const edge_t &edge: edges) {
+                if (edge.child != 0) {
+                    insert(edge);
+                }
+            }
+        }
+
+        edge_t edge = { edge_key(parent, id), child };
+        insert(edge);
+        return child;
+    }
+
+    void insert(const edge_t &edge) {
+        std::size_t mask = m_edges.size() - 1;
+        std::size_t i = slot(edge.key);
+
+        while (m_edges[i].child != 0) {
+            i = (i + 1) & mask;
+        }
+
+        m_edges[i] = edge;
+    }
+
+    // Walks all keys of a header except the last one, creating missing tables.
+    const char *open_parent(key_iterator_t begin, key_iterator_t end, std::uint32_t &parent) {
+        parent = 0;
+
+        for (; begin + 1 != end; ++begin) {
+            std::uint32_t id = m_interner.intern(*begin).id;
+            std::uint32_t node = find(parent, id);
+
+            if (node == 0) {
+                node = add(parent, id, node_kind_t::implicit_table);
+            } else if (m_nodes[node].kind == node_kind_t::table_array) {
+                node = m_nodes[node].last_element;
+            } else if (m_nodes[node].kind == node_kind_t::value) {
+                return "Key is already defined and isn't a table";
+            }
+
+            parent = node;
+        }
+
+        return nullptr;
+    }
+
+private:
+    key_interner_t m_interner;
+    std::vector<node_t> m_nodes;
+    std::vector<edge_t> m_edges;
+    std::size_t m_edges_count;
+    // Tables, inline tables and arrays enclosing the current value, the innermost is at the back.
+    std::vector<std::uint32_t> m_stack;
+    // Node of the last key, it becomes the parent if the value is an inline table.
+    std::uint32_t m_pending;
+};
+
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_KEY_CHECKER_HPP
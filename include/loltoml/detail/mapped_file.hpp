@@ -0,0 +1,129 @@
+#ifndef LOLTOML_DETAIL_MAPPED_FILE_HPP
+#define LOLTOML_DETAIL_MAPPED_FILE_HPP
+
+#include "loltoml/detail/common.hpp"
+#include "loltoml/error.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+// Read-only memory mapping of a whole file. Empty files are not mapped at all.
+// Files of other types (pipes, devices, /proc files) don't report their sizes and are read into memory instead.
+class mapped_file_t {
+public:
+    explicit mapped_file_t(const char *path) :
+        m_data(nullptr),
+        m_size(0),
+        m_mapped(false)
+    {
+        int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            throw_error("Unable to open file", path);
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) == -1) {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            throw_error("Unable to stat file", path);
+        }
+
+        if (!S_ISREG(info.st_mode)) {
+            read_all(fd, path);
+            ::close(fd);
+            return;
+        }
+
+        m_size = static_cast<std::size_t>(info.st_size);
+
+        if (m_size > 0) {
+            void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                int error = errno;
+                ::close(fd);
+                errno = error;
+                throw_error("Unable to map file", path);
+            }
+
+            m_data = static_cast<const char *>(data);
+            m_mapped = true;
+            ::madvise(data, m_size, MADV_SEQUENTIAL);
+        }
+
+        // The mapping stays valid after the descriptor is closed.
+        ::close(fd);
+    }
+
+    ~mapped_file_t() {
+        if (m_mapped) {
+            ::munmap(const_cast<char *>(m_data), m_size);
+        }
+    }
+
+    const char *begin() const {
+        return m_data;
+    }
+
+    const char *end() const {
+        return m_data + m_size;
+    }
+
+private:
+    mapped_file_t(const mapped_file_t &);
+    mapped_file_t &operator=(const mapped_file_t &);
+
+    void read_all(int fd, const char *path) {
+        char chunk[65536];
+
+        while (true) {
+            ssize_t size = ::read(fd, chunk, sizeof(chunk));
+
+            if (size == -1 && errno == EINTR) {
+                continue;
+            } else if (size == -1) {
+                int error = errno;
+                ::close(fd);
+                errno = error;
+                throw_error("Unable to read file", path);
+            } else if (size == 0) {
+                break;
+            }
+
+            m_buffer.append(chunk, static_cast<std::size_t>(size));
+        }
+
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+    }
+
+    static void throw_error(const char *what, const char *path) {
+        throw file_error_t(std::string(what) + " '" + path + "': " + std::strerror(errno));
+    }
+
+private:
+    const char *m_data;
+    std::size_t m_size;
+    bool m_mapped;
+    // Contents of files which aren't mapped.
+    std::string m_buffer;
+};
+
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_MAPPED_FILE_HPP
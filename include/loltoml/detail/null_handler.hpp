@@ -0,0 +1,19 @@
+#ifndef LOLTOML_DETAIL_NULL_HANDLER_HPP
+#define LOLTOML_DETAIL_NULL_HANDLER_HPP
+
+#include "loltoml/detail/common.hpp"
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+// Has no callbacks at all, so the parser skips building keys, strings, comments and table paths.
+struct null_handler_t { };
+
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_NULL_HANDLER_HPP
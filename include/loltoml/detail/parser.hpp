@@ -1,16 +1,25 @@
 #ifndef LOLTOML_DETAIL_PARSER_HPP
 #define LOLTOML_DETAIL_PARSER_HPP
 
+#include "loltoml/datetime.hpp"
+#include "loltoml/detail/callbacks.hpp"
 #include "loltoml/detail/common.hpp"
+#include "loltoml/detail/float_conversion.hpp"
+#include "loltoml/detail/input_buffer.hpp"
 #include "loltoml/detail/input_stream.hpp"
+#include "loltoml/detail/key_checker.hpp"
+#include "loltoml/detail/schema_cursor.hpp"
+#include "loltoml/detail/stop_after_keys.hpp"
+#include "loltoml/detail/token.hpp"
 #include "loltoml/error.hpp"
+#include "loltoml/key_interner.hpp"
 
 #include <cassert>
 #include <cctype>
 #include <cmath>
-#include <cstdlib>
+#include <cstdint>
 #include <cstring>
-#include <regex>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -64,6 +73,19 @@ inline bool is_word_character(char ch) {
 }
 
 
+inline bool is_datetime_character(char ch) {
+    return (ch >= '0' && ch <= '9') ||
+           ch == '-' ||
+           ch == ':' ||
+           ch == '.' ||
+           ch == '+' ||
+           ch == 'T' ||
+           ch == 't' ||
+           ch == 'Z' ||
+           ch == 'z';
+}
+
+
 inline bool is_key_character(char ch) {
     return (ch >= 'a' && ch <= 'z') ||
            (ch >= 'A' && ch <= 'Z') ||
@@ -73,31 +95,118 @@ inline bool is_key_character(char ch) {
 }
 
 
-typedef std::vector<std::string>::const_iterator key_iterator_t;
-
-
-template<class Handler>
+// Input is either input_stream_t or input_buffer_t.
+// OptionalFeatures enables stop_after_keys, key_checker, key_interner and schema_cursor,
+// without it their checks are compiled out of the parser.
+template<class Handler, class Input = input_stream_t, bool OptionalFeatures = false>
 class parser_t {
-    input_stream_t input;
-    Handler &handler;
+    typedef callbacks_t<Handler> callbacks_type;
+    typedef typename callbacks_type::string_type string_type;
+
+    Input input;
+    // Methods missing from the handler are skipped along with building their arguments.
+    callbacks_type handler;
+    // Current key, string, comment or symbol. Reused between tokens to avoid allocations.
+    token_t token;
+    // Keys of the last table header, only the first path_size are valid.
+    // Strings aren't destroyed between headers, so their capacity is reused.
+    std::vector<std::string> path;
+    std::size_t path_size;
+    // False until the first expression is parsed, every next one must start on a new line.
+    bool expression_parsed;
+    // True if the handler asked to skip the current [table] section.
+    bool skipping_section;
+    // Arrays and inline tables being parsed, with the numbers of their elements started so far.
+    struct open_container_t {
+        bool array;
+        std::size_t size;
+    };
+    std::vector<open_container_t> open_containers;
+    // Optional, stops parsing once all requested keys are delivered.
+    stop_after_keys_t *stop_after_keys;
+    // Optional, rejects keys and tables defined twice.
+    key_checker_t *key_checker;
+    // Optional, keys of key-value pairs are passed to the handler as interned_key_t if it accepts them.
+    key_interner_t *key_interner;
+    // Optional, keys of key-value pairs are passed to the handler as schema_key_t if it accepts them.
+    schema_cursor_t *schema_cursor;
 
 public:
-    parser_t(std::istream &input, Handler &handler) :
+    parser_t(const Input &input,
+             Handler &handler,
+             stop_after_keys_t *stop_after_keys = nullptr,
+             key_checker_t *key_checker = nullptr,
+             key_interner_t *key_interner = nullptr,
+             schema_cursor_t *schema_cursor = nullptr) :
         input(input),
-        handler(handler)
+        handler(handler),
+        token(!callbacks_type::discards_tokens || (OptionalFeatures && (stop_after_keys || key_checker || key_interner || schema_cursor))),
+        path_size(0),
+        expression_parsed(false),
+        skipping_section(false),
+        stop_after_keys(stop_after_keys),
+        key_checker(key_checker),
+        key_interner(key_interner),
+        schema_cursor(schema_cursor)
     { }
 
     void parse() {
-        handler.start_document();
+        try {
+            handler.start_document();
+            parse_expressions();
+        } catch (const stop_parsing_t &) {
+            // The handler asked to stop, the document is finished as is.
+            close_containers();
+        }
 
-        parse_expression();
+        handler.finish_document();
+    }
+
+    // Finishes the arrays and inline tables left open when parsing stops, so that handlers get balanced events.
+    // Elements are counted up to the one parsing stopped in.
+    void close_containers() {
+        while (!open_containers.empty()) {
+            open_container_t container = open_containers.back();
+
+            try {
+                if (container.array) {
+                    finish_array(container.size);
+                } else {
+                    finish_inline_table(container.size);
+                }
+            } catch (const stop_parsing_t &) {
+                // Parsing is stopped already.
+            }
+        }
+    }
+
+    // Parses expressions until the end of the input. Documents arriving in pieces are parsed with it expression by expression.
+    void parse_expressions() {
+        while (parse_next_expression()) { }
+    }
+
+    // Documents arriving in pieces are parsed by a parser per piece, a skipped section continues into the next piece.
+    bool skipping() const {
+        return skipping_section;
+    }
+
+    void set_skipping(bool skipping) {
+        skipping_section = skipping;
+    }
+
+    // Parses the next expression along with empty lines and comments before it. Returns false at the end of the input.
+    bool parse_next_expression() {
+        if (expression_parsed) {
+            if (input.eof()) {
+                return false;
+            }
 
-        while (!input.eof()) {
             parse_new_line();
-            parse_expression();
         }
 
-        handler.finish_document();
+        expression_parsed = true;
+        parse_expression();
+        return true;
     }
 
 private:
@@ -112,6 +221,10 @@ private:
         symbol,
     };
 
+    string_type token_string() {
+        return token_converter_t<string_type>::convert(token);
+    }
+
     std::size_t last_char_offset() const {
         std::size_t processed = input.processed();
         return (processed == 0) ? 0 : (processed - 1);
@@ -139,21 +252,19 @@ private:
     }
 
     void skip_spaces() {
-        while (!input.eof() && (input.peek() == ' ' || input.peek() == '\t')) {
-            input.get();
-        }
+        input.skip_spaces();
     }
 
     void parse_comment() {
         assert(input.peek() == '#');
         input.get();
 
-        std::string comment;
-        while (input.peek() == '\t' || !iscontrol(input.peek())) {
-            comment.push_back(input.get());
-        }
+        token.start(input.position());
+        input.read_comment(token);
 
-        handler.comment(comment);
+        if (callbacks_type::has_comment) {
+            handler.comment(token_string());
+        }
     }
 
     void parse_new_line() {
@@ -170,7 +281,7 @@ private:
 
     void skip_spaces_and_empty_lines() {
         while (!input.eof()) {
-            skip_spaces();
+            input.skip_whitespace();
 
             if (input.peek() == '#') {
                 parse_comment();
@@ -190,6 +301,8 @@ private:
             return;
         } else if (input.peek() == '\r' || input.peek() == '\n') {
             return;
+        } else if (skipping_section && input.peek() != '[') {
+            skip(true);
         } else if (input.peek() == '#') {
             parse_comment();
         } else if (input.peek() == '[') {
@@ -209,6 +322,7 @@ private:
 
     void parse_table_header() {
         assert(input.peek() == '[');
+        std::size_t header_offset = input.processed();
         input.get();
 
         bool array_item = false;
@@ -218,11 +332,22 @@ private:
             array_item = true;
         }
 
-        std::vector<std::string> path;
+        path_size = 0;
+
         while (true) {
             skip_spaces();
 
-            path.emplace_back(parse_key());
+            parse_key();
+
+            if ((array_item ? callbacks_type::has_array_table : callbacks_type::has_table) || has_optional_features()) {
+                if (path_size < path.size()) {
+                    path[path_size].assign(token.data(), token.size());
+                } else {
+                    path.emplace_back(token.data(), token.size());
+                }
+
+                ++path_size;
+            }
 
             skip_spaces();
 
@@ -239,45 +364,128 @@ private:
             }
         }
 
-        if (array_item) {
-            handler.array_table(path.cbegin(), path.cend());
-        } else {
-            handler.table(path.cbegin(), path.cend());
+        key_iterator_t path_begin = path.cbegin();
+        key_iterator_t path_end = path_begin + static_cast<std::ptrdiff_t>(path_size);
+
+        if (OptionalFeatures && key_checker) {
+            const char *error = array_item ? key_checker->array_table(path_begin, path_end)
+                                           : key_checker->table(path_begin, path_end);
+
+            if (error) {
+                throw parser_error_t(error, header_offset);
+            }
+        }
+
+        action_t action = array_item ? handler.array_table(path_begin, path_end)
+                                     : handler.table(path_begin, path_end);
+        skipping_section = (action == action_t::skip);
+
+        if (OptionalFeatures && stop_after_keys) {
+            stop_after_keys->table(path_begin, path_end);
+        }
+
+        if (OptionalFeatures && schema_cursor) {
+            schema_cursor->table(path_begin, path_end);
         }
     }
 
+    bool has_optional_features() const {
+        return OptionalFeatures && (stop_after_keys || key_checker || key_interner || schema_cursor);
+    }
+
     void parse_kv_pair() {
-        handler.key(parse_key());
+        if (has_optional_features()) {
+            parse_tracked_kv_pair();
+            return;
+        }
+
+        action_t action = parse_key_and_equals_sign();
+
+        if (action == action_t::skip) {
+            skip(false);
+        } else {
+            parse_value();
+        }
+    }
+
+    // Key-value pair with the optional features, it's kept apart to not slow down the usual one.
+    void parse_tracked_kv_pair() {
+        std::size_t key_offset = input.processed();
+        parse_key();
+
+        if (key_checker) {
+            if (const char *error = key_checker->key(token.data(), token.size())) {
+                throw parser_error_t(error, key_offset);
+            }
+        }
+
+        if (stop_after_keys) {
+            stop_after_keys->start_value(token.data(), token.size());
+        }
+
+        action_t action = action_t::proceed;
+
+        if (callbacks_type::has_schema_key && schema_cursor) {
+            action = handler.key(schema_cursor->key(token.data(), token.size()));
+        } else if (callbacks_type::has_interned_key && key_interner) {
+            action = handler.key(key_interner->intern(string_ref_t(token.data(), token.size())));
+        } else if (callbacks_type::has_key) {
+            action = handler.key(token_string());
+        }
+
+        skip_spaces();
+        parse_chars("=");
+        skip_spaces();
+
+        if (action == action_t::skip) {
+            skip(false);
+        } else {
+            parse_value();
+        }
+
+        if (stop_after_keys && stop_after_keys->finish_value()) {
+            throw stop_parsing_t();
+        }
+    }
+
+    // Reads "key =" of a key-value pair and passes the key to the handler.
+    action_t parse_key_and_equals_sign() {
+        parse_key();
+
+        action_t action = action_t::proceed;
+
+        if (callbacks_type::has_key) {
+            action = handler.key(token_string());
+        }
+
         skip_spaces();
         parse_chars("=");
         skip_spaces();
-        parse_value();
+
+        return action;
     }
 
-    std::string parse_key() {
-        std::string key;
+    // Reads a key into the token.
+    void parse_key() {
         if (input.peek() == '"') {
             input.get();
-            key = parse_basic_string();
+            parse_basic_string();
 
-            if (key.empty()) {
+            if (token.size() == 0) {
                 throw parser_error_t("Expected a non-empty key", last_char_offset());
             }
         } else {
             // It must be at least one char.
-            char ch = input.get();
-            if (!is_key_character(ch)) {
+            if (!is_key_character(input.peek())) {
+                input.get();
                 throw parser_error_t("Expected a non-empty key", last_char_offset());
             }
 
-            key.push_back(ch);
-
+            token.start(input.position());
             while (is_key_character(input.peek())) {
-                key.push_back(input.get());
+                token.append_source(input.get());
             }
         }
-
-        return key;
     }
 
     toml_type_t parse_value() {
@@ -308,19 +516,32 @@ private:
         assert(input.peek() == '[');
         input.get();
         handler.start_array();
+
+        if (OptionalFeatures && key_checker) {
+            key_checker->start_array();
+        }
+
+        if (OptionalFeatures && schema_cursor) {
+            schema_cursor->start_container(true);
+        }
+
         skip_spaces_and_empty_lines();
 
-        toml_type_t array_type;
+        toml_type_t array_type = toml_type_t::array;
         std::size_t size = 0;
+        std::size_t container = open_containers.size();
+        open_container_t open = { true, 0 };
+        open_containers.push_back(open);
 
         while (true) {
             if (input.peek() == ']') {
                 input.get();
-                handler.finish_array(size);
+                finish_array(size);
                 return;
             }
 
             std::size_t item_offset = input.processed();
+            open_containers[container].size = size + 1;
             toml_type_t current_item_type = parse_value();
 
             if (size > 0 && current_item_type != array_type) {
@@ -335,7 +556,7 @@ private:
 
             char ch = input.get();
             if (ch == ']') {
-                handler.finish_array(size);
+                finish_array(size);
                 return;
             } else if (ch == ',') {
                 skip_spaces_and_empty_lines();
@@ -349,29 +570,38 @@ private:
         assert(input.peek() == '{');
         input.get();
         handler.start_inline_table();
+
+        if (OptionalFeatures && key_checker) {
+            key_checker->start_inline_table();
+        }
+
+        if (OptionalFeatures && schema_cursor) {
+            schema_cursor->start_container(false);
+        }
+
         std::size_t size = 0;
+        std::size_t container = open_containers.size();
+        open_container_t open = { false, 0 };
+        open_containers.push_back(open);
 
         skip_spaces();
 
         if (input.peek() == '}') {
             input.get();
-            handler.finish_inline_table(size);
+            finish_inline_table(size);
             return;
         }
 
         while (true) {
-            handler.key(parse_key());
-            skip_spaces();
-            parse_chars("=");
-            skip_spaces();
-            parse_value();
+            open_containers[container].size = size + 1;
+            parse_kv_pair();
             skip_spaces();
 
             ++size;
 
             char ch = input.get();
             if (ch == '}') {
-                handler.finish_inline_table(size);
+                finish_inline_table(size);
                 return;
             } else if (ch == ',') {
                 skip_spaces();
@@ -381,6 +611,151 @@ private:
         }
     }
 
+    void finish_array(std::size_t size) {
+        open_containers.pop_back();
+
+        if (OptionalFeatures && key_checker) {
+            key_checker->finish_array();
+        }
+
+        if (OptionalFeatures && schema_cursor) {
+            schema_cursor->finish_container();
+        }
+
+        handler.finish_array(size);
+    }
+
+    void finish_inline_table(std::size_t size) {
+        open_containers.pop_back();
+
+        if (OptionalFeatures && key_checker) {
+            key_checker->finish_inline_table();
+        }
+
+        if (OptionalFeatures && schema_cursor) {
+            schema_cursor->finish_container();
+        }
+
+        handler.finish_inline_table(size);
+    }
+
+    /*
+     * Skips a value (or the rest of the line if whole_line is set) without validating it and without calling the handler.
+     * It only tracks strings, comments and brackets to find where the value ends.
+     */
+    void skip(bool whole_line) {
+        std::size_t depth = 0;
+
+        while (true) {
+            char ch = input.peek();
+
+            switch (ch) {
+                case '"':
+                case '\'':
+                    skip_string();
+                    break;
+                case '[':
+                case '{':
+                    input.get();
+                    ++depth;
+                    break;
+                case ']':
+                case '}':
+                    if (depth == 0 && !whole_line) {
+                        return;
+                    }
+
+                    input.get();
+
+                    if (depth > 0 && --depth == 0 && !whole_line) {
+                        return;
+                    }
+                    break;
+                case '#':
+                    if (depth == 0 && !whole_line) {
+                        return;
+                    }
+
+                    input.get();
+                    input.skip_comment();
+                    break;
+                case '\r':
+                case '\n':
+                    if (depth == 0) {
+                        return;
+                    }
+
+                    input.get();
+                    break;
+                case ' ':
+                case '\t':
+                case ',':
+                    if (depth == 0 && !whole_line) {
+                        return;
+                    }
+
+                    input.skip_unstructured_run();
+                    break;
+                default:
+                    if (depth == 0 && !whole_line) {
+                        // Spaces and commas end scalar values.
+                        input.get();
+                    } else {
+                        input.skip_unstructured_run();
+                    }
+            }
+        }
+    }
+
+    // Skips a string of any kind starting at the current character.
+    void skip_string() {
+        char quote = input.get();
+
+        if (input.peek() != quote) {
+            skip_string_contents(quote, false);
+            return;
+        }
+
+        input.get();
+
+        if (input.peek() == quote) {
+            input.get();
+            skip_string_contents(quote, true);
+        }
+    }
+
+    // Skips the rest of a string after the opening quotes.
+    void skip_string_contents(char quote, bool multiline) {
+        while (true) {
+            if (quote == '"') {
+                input.skip_basic_string_run();
+            } else {
+                input.skip_literal_string_run();
+            }
+
+            char ch = input.get();
+
+            if (ch == quote) {
+                if (!multiline) {
+                    return;
+                }
+
+                if (input.peek() == quote) {
+                    input.get();
+
+                    if (input.peek() == quote) {
+                        input.get();
+                        return;
+                    }
+                }
+            } else if (ch == '\\' && quote == '"') {
+                input.get();
+            } else if ((ch == '\r' || ch == '\n') && !multiline) {
+                throw parser_error_t("Control characters must be escaped", last_char_offset());
+            }
+        }
+    }
+
     unsigned int parse_hex_digit() {
         char ch = input.get();
 
@@ -417,7 +792,7 @@ private:
         return codepoint;
     }
 
-    void process_codepoint(uint32_t codepoint, std::size_t escape_sequence_offset, std::string &output) {
+    void process_codepoint(uint32_t codepoint, std::size_t escape_sequence_offset) {
         if (codepoint >= 0xD800 && codepoint <= 0xDFFF) {
             throw parser_error_t("Surrogate pairs are not allowed", escape_sequence_offset);
         }
@@ -427,26 +802,29 @@ private:
         }
 
         if (codepoint <= 0x7F) {
-            output.push_back(static_cast<unsigned char>(codepoint));
+            token.push_back(static_cast<unsigned char>(codepoint));
         } else if (codepoint <= 0x7FF) {
-            output.push_back(static_cast<unsigned char>(0xC0 | (codepoint >> 6)));
-            output.push_back(static_cast<unsigned char>(0x80 | (codepoint & 0x3F)));
+            token.push_back(static_cast<unsigned char>(0xC0 | (codepoint >> 6)));
+            token.push_back(static_cast<unsigned char>(0x80 | (codepoint & 0x3F)));
         } else if (codepoint <= 0xFFFF) {
-            output.push_back(static_cast<unsigned char>(0xE0 | (codepoint >> 12)));
-            output.push_back(static_cast<unsigned char>(0x80 | ((codepoint >> 6) & 0x3F)));
-            output.push_back(static_cast<unsigned char>(0x80 | (codepoint & 0x3F)));
+            token.push_back(static_cast<unsigned char>(0xE0 | (codepoint >> 12)));
+            token.push_back(static_cast<unsigned char>(0x80 | ((codepoint >> 6) & 0x3F)));
+            token.push_back(static_cast<unsigned char>(0x80 | (codepoint & 0x3F)));
         } else {
-            output.push_back(static_cast<unsigned char>(0xF0 | (codepoint >> 18)));
-            output.push_back(static_cast<unsigned char>(0x80 | ((codepoint >> 12) & 0x3F)));
-            output.push_back(static_cast<unsigned char>(0x80 | ((codepoint >> 6) & 0x3F)));
-            output.push_back(static_cast<unsigned char>(0x80 | (codepoint & 0x3F)));
+            token.push_back(static_cast<unsigned char>(0xF0 | (codepoint >> 18)));
+            token.push_back(static_cast<unsigned char>(0x80 | ((codepoint >> 12) & 0x3F)));
+            token.push_back(static_cast<unsigned char>(0x80 | ((codepoint >> 6) & 0x3F)));
+            token.push_back(static_cast<unsigned char>(0x80 | (codepoint & 0x3F)));
         }
     }
 
-    std::string parse_basic_string() {
-        std::string result;
+    // Reads a basic string into the token. The opening quote must be already consumed.
+    void parse_basic_string() {
+        token.start(input.position());
 
         while (true) {
+            input.read_basic_string_run(token);
+
             char ch = input.get();
             if (iscontrol(ch)) {
                 throw parser_error_t("Control characters must be escaped", last_char_offset());
@@ -456,46 +834,47 @@ private:
                 std::size_t escape_sequence_offset = last_char_offset();
                 char ch = input.get();
                 if (ch == 'b') {
-                    result.push_back('\b');
+                    token.push_back('\b');
                 } else if (ch == 't') {
-                    result.push_back('\t');
+                    token.push_back('\t');
                 } else if (ch == 'n') {
-                    result.push_back('\n');
+                    token.push_back('\n');
                 } else if (ch == 'f') {
-                    result.push_back('\f');
+                    token.push_back('\f');
                 } else if (ch == 'r') {
-                    result.push_back('\r');
+                    token.push_back('\r');
                 } else if (ch == '"') {
-                    result.push_back('"');
+                    token.push_back('"');
                 } else if (ch == '\\') {
-                    result.push_back('\\');
+                    token.push_back('\\');
                 } else if (ch == 'u') {
-                    process_codepoint(parse_4_digit_codepoint(), escape_sequence_offset, result);
+                    process_codepoint(parse_4_digit_codepoint(), escape_sequence_offset);
                 } else if (ch == 'U') {
-                    process_codepoint(parse_8_digit_codepoint(), escape_sequence_offset, result);
+                    process_codepoint(parse_8_digit_codepoint(), escape_sequence_offset);
                 } else {
                     throw parser_error_t("Invalid escape-sequence", escape_sequence_offset);
                 }
             } else {
-                result.push_back(ch);
+                token.append_source(ch);
             }
         }
-
-        return result;
     }
 
-    std::string parse_multiline_string() {
-        std::string result;
-
+    // Reads a multi-line basic string into the token. The opening quotes must be already consumed.
+    void parse_multiline_string() {
         // Ignore first new-line after open quotes.
         if (input.peek() == '\r' || input.peek() == '\n') {
             parse_new_line();
         }
 
+        token.start(input.position());
+
         while (true) {
+            input.read_basic_string_run(token);
+
             if (input.peek() == '\r' || input.peek() == '\n') {
                 parse_new_line();
-                result.push_back('\n');
+                token.push_back('\n');
                 continue;
             }
 
@@ -509,11 +888,12 @@ private:
                         input.get();
                         break;
                     }
-                    result.push_back('"');
+                    token.append_source('"');
                 }
-                result.push_back('"');
+                token.append_source('"');
             } else if (ch == '\\') {
                 if (input.peek() == '\r' || input.peek() == '\n') {
+                    token.materialize();
                     parse_new_line();
                     while (std::isspace(input.peek())) {
                         input.get();
@@ -524,32 +904,30 @@ private:
                 std::size_t escape_sequence_offset = last_char_offset();
                 char ch = input.get();
                 if (ch == 'b') {
-                    result.push_back('\b');
+                    token.push_back('\b');
                 } else if (ch == 't') {
-                    result.push_back('\t');
+                    token.push_back('\t');
                 } else if (ch == 'n') {
-                    result.push_back('\n');
+                    token.push_back('\n');
                 } else if (ch == 'f') {
-                    result.push_back('\f');
+                    token.push_back('\f');
                 } else if (ch == 'r') {
-                    result.push_back('\r');
+                    token.push_back('\r');
                 } else if (ch == '"') {
-                    result.push_back('"');
+                    token.push_back('"');
                 } else if (ch == '\\') {
-                    result.push_back('\\');
+                    token.push_back('\\');
                 } else if (ch == 'u') {
-                    process_codepoint(parse_4_digit_codepoint(), escape_sequence_offset, result);
+                    process_codepoint(parse_4_digit_codepoint(), escape_sequence_offset);
                 } else if (ch == 'U') {
-                    process_codepoint(parse_8_digit_codepoint(), escape_sequence_offset, result);
+                    process_codepoint(parse_8_digit_codepoint(), escape_sequence_offset);
                 } else {
                     throw parser_error_t("Invalid escape-sequence", escape_sequence_offset);
                 }
             } else {
-                result.push_back(ch);
+                token.append_source(ch);
             }
         }
-
-        return result;
     }
 
     void parse_string() {
@@ -561,12 +939,16 @@ private:
 
             if (input.peek() == '"') {
                 input.get();
-                handler.string(parse_multiline_string());
+                parse_multiline_string();
             } else {
-                handler.string("");
+                token.start(nullptr);
             }
         } else {
-            handler.string(parse_basic_string());
+            parse_basic_string();
+        }
+
+        if (callbacks_type::has_string) {
+            handler.string(token_string());
         }
     }
 
@@ -585,11 +967,13 @@ private:
                     parse_new_line();
                 }
 
-                std::string string;
+                token.start(input.position());
                 while (true) {
+                    input.read_literal_string_run(token);
+
                     if (input.peek() == '\r' || input.peek() == '\n') {
                         parse_new_line();
-                        string.push_back('\n');
+                        token.push_back('\n');
                         continue;
                     }
 
@@ -599,25 +983,26 @@ private:
                             input.get();
                             if (input.peek() == '\'') {
                                 input.get();
-                                handler.string(string);
-                                return;
+                                break;
                             }
-                            string.push_back('\'');
+                            token.append_source('\'');
                         }
-                        string.push_back('\'');
+                        token.append_source('\'');
                     } else if (iscontrol(ch) && ch != '\t') {
                         throw parser_error_t("Control characters are not allowed", last_char_offset());
                     } else {
-                        string.push_back(ch);
+                        token.append_source(ch);
                     }
                 }
             } else {
-                handler.string("");
+                token.start(nullptr);
             }
         } else {
-            std::string string;
+            token.start(input.position());
 
             while (true) {
+                input.read_literal_string_run(token);
+
                 char ch = input.get();
                 if (iscontrol(ch) && ch != '\t') {
                     throw parser_error_t("Control characters are not allowed", last_char_offset());
@@ -625,48 +1010,210 @@ private:
                     break;
                 }
 
-                string.push_back(ch);
+                token.append_source(ch);
             }
+        }
 
-            handler.string(string);
+        if (callbacks_type::has_string) {
+            handler.string(token_string());
         }
     }
 
     toml_type_t parse_bool_or_number_or_symbol() {
-        std::string result;
-        char ch = input.get();
-        if (!is_word_character(ch)) {
+        char ch = input.peek();
+
+        if ((ch >= '0' && ch <= '9') || ch == '+' || ch == '-') {
+            return parse_number();
+        } else if (is_word_character(ch)) {
+            return parse_bool_or_symbol();
+        } else {
+            input.get();
             throw parser_error_t("Expected a non-empty symbol", last_char_offset());
         }
+    }
 
-        result.push_back(ch);
+    toml_type_t parse_bool_or_symbol() {
+        std::size_t token_offset = input.processed();
 
+        token.start(input.position());
         while (is_word_character(input.peek())) {
-            result.push_back(input.get());
+            token.append_source(input.get());
         }
 
-        if (result == "true") {
+        if (token.size() == 4 && std::memcmp(token.data(), "true", 4) == 0) {
             handler.boolean(true);
             return toml_type_t::boolean;
-        }
-        else if (result == "false") {
+        } else if (token.size() == 5 && std::memcmp(token.data(), "false", 5) == 0) {
             handler.boolean(false);
             return toml_type_t::boolean;
         }
-        else if (std::regex_match(result, std::regex("^\\d+$"))) {
-            handler.integer(std::stoll(result));
-            return toml_type_t::integer;
+
+        // Symbols look like identifiers: [a-zA-Z_][a-zA-Z0-9_]*
+        for (std::size_t i = 0; i < token.size(); ++i) {
+            if (!is_key_character(token.data()[i]) || token.data()[i] == '-') {
+                throw parser_error_t("Invalid value", token_offset);
+            }
         }
-        //else if (std::regex_match(result, std::regex("^[-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?$"))) {
-        else if (std::regex_match(result, std::regex("^[-+]?((\\d*.\\d+)|(\\d+.\\d*)|\\d+)([eE][-+]?\\d+)?$"))) {
-            handler.floating_point(std::stod(result));
-            return toml_type_t::floating_point;
+
+        if (callbacks_type::has_symbol) {
+            handler.symbol(token_string());
+        }
+        return toml_type_t::symbol;
+    }
+
+    // Reads a sequence of digits optionally separated by single underscores and appends them to the decimal.
+    void parse_digits(bool allow_leading_zeros, decimal_t &decimal, bool fractional) {
+        char ch = input.get();
+        if (ch < '0' || ch > '9') {
+            throw parser_error_t("Expected a digit", last_char_offset());
+        }
+
+        if (!allow_leading_zeros && ch == '0' && (std::isdigit(input.peek()) || input.peek() == '_')) {
+            throw parser_error_t("Leading zeros are not allowed", last_char_offset());
+        }
+
+        while (true) {
+            token.append_source(ch);
+            decimal.append(static_cast<unsigned int>(ch - '0'), fractional);
+
+            if (input.peek() == '_') {
+                // The token keeps the number without underscores for strtod_c_locale().
+                token.materialize();
+                input.get();
+                if (!std::isdigit(input.peek())) {
+                    throw parser_error_t("Underscores must be surrounded by digits", last_char_offset());
+                }
+            } else if (!std::isdigit(input.peek())) {
+                break;
+            }
+
+            ch = input.get();
         }
-        else if (std::regex_match(result, std::regex("^[a-zA-Z_][a-zA-Z0-9_]*$"))) {
-            handler.symbol(result);
-            return toml_type_t::symbol;
+    }
+
+    // Reads the rest of a datetime, its first digits are already in the token.
+    // It's not inlined to keep parse_number() small, which is called much more often.
+    LOLTOML_NOINLINE toml_type_t parse_datetime(std::size_t token_offset) {
+        while (is_datetime_character(input.peek())) {
+            token.append_source(input.get());
+        }
+
+        datetime_t value;
+
+        if (!loltoml::parse_datetime(string_ref_t(token.data(), token.size()), value)) {
+            throw parser_error_t("Invalid datetime", token_offset);
+        }
+
+        if (callbacks_type::has_datetime_text) {
+            handler.datetime(value, token_string());
+        } else {
+            handler.datetime(value);
+        }
+
+        return toml_type_t::datetime;
+    }
+
+    // Scans and converts an integer or a float in a single pass.
+    // The token is used only by the rare floats which cannot be converted without the full text.
+    toml_type_t parse_number() {
+        std::size_t token_offset = input.processed();
+        bool negative = false;
+
+        token.start(input.position());
+
+        if (input.peek() == '+' || input.peek() == '-') {
+            negative = (input.peek() == '-');
+            token.append_source(input.get());
+        }
+
+        decimal_t decimal;
+        bool is_float = false;
+
+        // Leading zeros are checked after the digits, because datetimes may have them.
+        std::size_t digits_offset = input.processed();
+        bool leading_zero = (input.peek() == '0');
+        parse_digits(true, decimal, false);
+        std::size_t digits_length = input.processed() - digits_offset;
+
+        // Datetimes start with a year or an hour: 1979-05-27, 07:32:00.
+        char next = input.peek();
+
+        if (next == '-' || next == ':') {
+            // Neither a sign nor underscores.
+            if (digits_length == (next == '-' ? 4u : 2u) && digits_offset == token_offset && token.size() == digits_length) {
+                return parse_datetime(token_offset);
+            }
+        }
+
+        if (leading_zero && digits_length > 1) {
+            throw parser_error_t("Leading zeros are not allowed", digits_offset);
+        }
+
+        // Integer digits beyond the 19th increase the exponent.
+        bool integer_overflow = (decimal.exponent > 0);
+
+        if (input.peek() == '.') {
+            is_float = true;
+            token.append_source(input.get());
+            parse_digits(true, decimal, true);
+        }
+
+        if (input.peek() == 'e' || input.peek() == 'E') {
+            is_float = true;
+            token.append_source(input.get());
+
+            bool negative_exponent = false;
+
+            if (input.peek() == '+' || input.peek() == '-') {
+                negative_exponent = (input.peek() == '-');
+                token.append_source(input.get());
+            }
+
+            decimal_t exponent;
+            parse_digits(false, exponent, false);
+
+            // Anything this large overflows or underflows anyway.
+            const std::int64_t max_exponent = 100000;
+            std::int64_t exponent_value = (exponent.digits > 6 || exponent.exponent > 0) ?
+                max_exponent :
+                static_cast<std::int64_t>(exponent.significand);
+
+            decimal.exponent += negative_exponent ? -exponent_value : exponent_value;
+        }
+
+        if (is_word_character(input.peek())) {
+            input.get();
+            throw parser_error_t("Invalid character in a number", last_char_offset());
+        }
+
+        if (is_float) {
+            double value;
+
+            if (!decimal_to_double(decimal, negative, &value)) {
+                value = strtod_c_locale(token.str());
+            }
+
+            if (std::isinf(value)) {
+                throw parser_error_t("Float is out of range", token_offset);
+            }
+
+            handler.floating_point(value);
+            return toml_type_t::floating_point;
+        } else {
+            const std::uint64_t max_positive = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+            std::uint64_t magnitude = decimal.significand;
+
+            if (integer_overflow || magnitude > max_positive + (negative ? 1 : 0)) {
+                throw parser_error_t("Integer is out of range", token_offset);
+            }
+
+            std::int64_t value = negative ?
+                static_cast<std::int64_t>(0 - magnitude) :
+                static_cast<std::int64_t>(magnitude);
+
+            handler.integer(value);
+            return toml_type_t::integer;
         }
-        throw parser_error_t("Invalid value", 0);
     }
 };
 
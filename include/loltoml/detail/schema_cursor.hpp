@@ -0,0 +1,99 @@
+#ifndef LOLTOML_DETAIL_SCHEMA_CURSOR_HPP
+#define LOLTOML_DETAIL_SCHEMA_CURSOR_HPP
+
+#include "loltoml/detail/callbacks.hpp"
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/hash.hpp"
+#include "loltoml/key_schema.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+/*
+ * Looks keys of key-value pairs up in a key_schema_t (see parse_options_t::key_schema).
+ *
+ * The path of the current key is kept in a single string: the prefix of the enclosing tables followed by the key.
+ * Every container keeps the length and the hash of its prefix, so a key is hashed only once, starting from the hash
+ * of the prefix, and containers of a value extend the prefix of the key without rehashing it.
+ */
+class schema_cursor_t {
+public:
+    explicit schema_cursor_t(const key_schema_t &schema) :
+        m_schema(schema),
+        m_key_hash(hash_basis)
+    {
+        frame_t root = { hash_basis, 0, false };
+        m_frames.push_back(root);
+    }
+
+    void table(key_iterator_t begin, key_iterator_t end) {
+        m_path.clear();
+
+        for (; begin != end; ++begin) {
+            m_path += *begin;
+            m_path += '.';
+        }
+
+        frame_t frame = { hash_append(hash_basis, m_path.data(), m_path.size()), m_path.size(), false };
+        m_frames.assign(1, frame);
+    }
+
+    schema_key_t key(const char *data, std::size_t size) {
+        const frame_t &frame = m_frames.back();
+
+        m_path.resize(frame.path_size);
+        m_path.append(data, size);
+        m_key_hash = hash_append(frame.hash, data, size);
+
+        schema_key_t result = { m_schema.find(m_key_hash, m_path), string_ref_t(data, size) };
+        return result;
+    }
+
+    // Elements of arrays are addressed by the key of the array, without indices.
+    void start_container(bool array) {
+        frame_t frame = m_frames.back();
+
+        // Otherwise it's the value of the last key, whose path is in m_path.
+        if (!frame.array) {
+            m_path += '.';
+            frame.hash = hash_append(m_key_hash, ".", 1);
+            frame.path_size = m_path.size();
+        }
+
+        frame.array = array;
+        m_frames.push_back(frame);
+    }
+
+    void finish_container() {
+        m_frames.pop_back();
+    }
+
+private:
+    struct frame_t {
+        // Hash and length of the prefix of keys in the container, including the trailing dot.
+        std::uint64_t hash;
+        std::size_t path_size;
+        bool array;
+    };
+
+private:
+    const key_schema_t &m_schema;
+    std::vector<frame_t> m_frames;
+    // Prefix of the innermost container followed by the last key.
+    std::string m_path;
+    std::uint64_t m_key_hash;
+};
+
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_SCHEMA_CURSOR_HPP
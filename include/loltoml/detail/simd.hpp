@@ -0,0 +1,253 @@
+#ifndef LOLTOML_DETAIL_SIMD_HPP
+#define LOLTOML_DETAIL_SIMD_HPP
+
+#include "loltoml/detail/common.hpp"
+
+#include <cstddef>
+
+/*
+ * Vectorized scanning of memory buffers.
+ * SSE2 is used when it's available at compile time, AVX2 is detected at run time (GCC and Clang only).
+ * Define LOLTOML_DISABLE_SIMD to use only the scalar code.
+ */
+#if !defined(LOLTOML_DISABLE_SIMD) && defined(__SSE2__)
+#define LOLTOML_SIMD_SSE2 1
+#include <emmintrin.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LOLTOML_SIMD_AVX2 1
+#include <immintrin.h>
+#endif
+#endif
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+namespace simd {
+
+
+// Character classes searched by the kernels.
+struct blank_class_t {
+    static bool contains(char ch) {
+        return ch == ' ' || ch == '\t';
+    }
+};
+
+struct whitespace_class_t {
+    static bool contains(char ch) {
+        return ch == ' ' || ch == '\t' || ch == '\n';
+    }
+};
+
+// Characters allowed in a comment: everything except control characters, though '\t' is allowed.
+struct comment_class_t {
+    static bool contains(char ch) {
+        return ch == '\t' || static_cast<unsigned char>(ch) >= 32;
+    }
+};
+
+// Characters which can be copied from a basic string as is: no quotes, backslashes and control characters.
+struct basic_string_class_t {
+    static bool contains(char ch) {
+        return ch != '"' && ch != '\\' && static_cast<unsigned char>(ch) >= 32;
+    }
+};
+
+// Characters which can be copied from a literal string as is: no apostrophes and control characters except '\t'.
+struct literal_string_class_t {
+    static bool contains(char ch) {
+        return ch != '\'' && comment_class_t::contains(ch);
+    }
+};
+
+// Characters which don't affect the structure of skipped values: no quotes, brackets, braces, '#' and new-lines.
+struct unstructured_class_t {
+    static bool contains(char ch) {
+        return ch != '"' && ch != '\'' && ch != '[' && ch != ']' && ch != '{' && ch != '}' &&
+               ch != '#' && ch != '\r' && ch != '\n';
+    }
+};
+
+
+#if LOLTOML_SIMD_SSE2
+
+inline unsigned int count_trailing_zeros(unsigned int mask) {
+    return static_cast<unsigned int>(__builtin_ctz(mask));
+}
+
+// Each function returns a mask with bits set for bytes belonging to the class.
+inline unsigned int sse2_mask(__m128i block, blank_class_t) {
+    __m128i spaces = _mm_cmpeq_epi8(block, _mm_set1_epi8(' '));
+    __m128i tabs = _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'));
+    return static_cast<unsigned int>(_mm_movemask_epi8(_mm_or_si128(spaces, tabs)));
+}
+
+inline unsigned int sse2_mask(__m128i block, whitespace_class_t) {
+    __m128i new_lines = _mm_cmpeq_epi8(block, _mm_set1_epi8('\n'));
+    return sse2_mask(block, blank_class_t()) | static_cast<unsigned int>(_mm_movemask_epi8(new_lines));
+}
+
+inline unsigned int sse2_mask(__m128i block, comment_class_t) {
+    // Unsigned ch < 32 <=> min(ch, 31) == ch.
+    __m128i controls = _mm_cmpeq_epi8(_mm_min_epu8(block, _mm_set1_epi8(31)), block);
+    __m128i tabs = _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'));
+    return ~static_cast<unsigned int>(_mm_movemask_epi8(_mm_andnot_si128(tabs, controls))) & 0xFFFF;
+}
+
+inline unsigned int sse2_mask(__m128i block, basic_string_class_t) {
+    __m128i controls = _mm_cmpeq_epi8(_mm_min_epu8(block, _mm_set1_epi8(31)), block);
+    __m128i quotes = _mm_cmpeq_epi8(block, _mm_set1_epi8('"'));
+    __m128i backslashes = _mm_cmpeq_epi8(block, _mm_set1_epi8('\\'));
+    __m128i stops = _mm_or_si128(controls, _mm_or_si128(quotes, backslashes));
+    return ~static_cast<unsigned int>(_mm_movemask_epi8(stops)) & 0xFFFF;
+}
+
+inline unsigned int sse2_mask(__m128i block, literal_string_class_t) {
+    __m128i apostrophes = _mm_cmpeq_epi8(block, _mm_set1_epi8('\''));
+    return sse2_mask(block, comment_class_t()) & ~static_cast<unsigned int>(_mm_movemask_epi8(apostrophes));
+}
+
+inline unsigned int sse2_mask(__m128i block, unstructured_class_t) {
+    __m128i quotes = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('"')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\'')));
+    __m128i brackets = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('[')), _mm_cmpeq_epi8(block, _mm_set1_epi8(']')));
+    __m128i braces = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('{')), _mm_cmpeq_epi8(block, _mm_set1_epi8('}')));
+    __m128i comments = _mm_cmpeq_epi8(block, _mm_set1_epi8('#'));
+    __m128i new_lines = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\n')));
+    __m128i stops = _mm_or_si128(_mm_or_si128(quotes, _mm_or_si128(brackets, braces)), _mm_or_si128(comments, new_lines));
+    return ~static_cast<unsigned int>(_mm_movemask_epi8(stops)) & 0xFFFF;
+}
+
+template<class Class>
+inline const char *sse2_skip(const char *begin, const char *end) {
+    while (end - begin >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        unsigned int mask = sse2_mask(block, Class()) ^ 0xFFFF;
+
+        if (mask != 0) {
+            return begin + count_trailing_zeros(mask);
+        }
+
+        begin += 16;
+    }
+
+    while (begin != end && Class::contains(*begin)) {
+        ++begin;
+    }
+
+    return begin;
+}
+
+#endif // LOLTOML_SIMD_SSE2
+
+
+#if LOLTOML_SIMD_AVX2
+
+__attribute__((target("avx2")))
+inline unsigned int avx2_mask(__m256i block, blank_class_t) {
+    __m256i spaces = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(' '));
+    __m256i tabs = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\t'));
+    return static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_or_si256(spaces, tabs)));
+}
+
+__attribute__((target("avx2")))
+inline unsigned int avx2_mask(__m256i block, whitespace_class_t) {
+    __m256i new_lines = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n'));
+    return avx2_mask(block, blank_class_t()) | static_cast<unsigned int>(_mm256_movemask_epi8(new_lines));
+}
+
+__attribute__((target("avx2")))
+inline unsigned int avx2_mask(__m256i block, comment_class_t) {
+    __m256i controls = _mm256_cmpeq_epi8(_mm256_min_epu8(block, _mm256_set1_epi8(31)), block);
+    __m256i tabs = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\t'));
+    return ~static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_andnot_si256(tabs, controls)));
+}
+
+__attribute__((target("avx2")))
+inline unsigned int avx2_mask(__m256i block, basic_string_class_t) {
+    __m256i controls = _mm256_cmpeq_epi8(_mm256_min_epu8(block, _mm256_set1_epi8(31)), block);
+    __m256i quotes = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('"'));
+    __m256i backslashes = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\\'));
+    __m256i stops = _mm256_or_si256(controls, _mm256_or_si256(quotes, backslashes));
+    return ~static_cast<unsigned int>(_mm256_movemask_epi8(stops));
+}
+
+__attribute__((target("avx2")))
+inline unsigned int avx2_mask(__m256i block, literal_string_class_t) {
+    __m256i apostrophes = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\''));
+    return avx2_mask(block, comment_class_t()) & ~static_cast<unsigned int>(_mm256_movemask_epi8(apostrophes));
+}
+
+__attribute__((target("avx2")))
+inline unsigned int avx2_mask(__m256i block, unstructured_class_t) {
+    __m256i quotes = _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\'')));
+    __m256i brackets = _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('[')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8(']')));
+    __m256i braces = _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('}')));
+    __m256i comments = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('#'));
+    __m256i new_lines = _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\r')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n')));
+    __m256i stops = _mm256_or_si256(_mm256_or_si256(quotes, _mm256_or_si256(brackets, braces)), _mm256_or_si256(comments, new_lines));
+    return ~static_cast<unsigned int>(_mm256_movemask_epi8(stops));
+}
+
+template<class Class>
+__attribute__((target("avx2")))
+inline const char *avx2_skip(const char *begin, const char *end) {
+    while (end - begin >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+        unsigned int mask = ~avx2_mask(block, Class());
+
+        if (mask != 0) {
+            return begin + count_trailing_zeros(mask);
+        }
+
+        begin += 32;
+    }
+
+    return sse2_skip<Class>(begin, end);
+}
+
+inline bool has_avx2() {
+    static const bool result = __builtin_cpu_supports("avx2");
+    return result;
+}
+
+#endif // LOLTOML_SIMD_AVX2
+
+
+// Returns pointer to the first character in [begin, end) not belonging to the class, or end.
+template<class Class>
+inline const char *skip(const char *begin, const char *end) {
+    // Most runs are short (e.g. a single space around '='), so check a few characters before going wide.
+    for (int i = 0; i < 8; ++i) {
+        if (begin == end || !Class::contains(*begin)) {
+            return begin;
+        }
+
+        ++begin;
+    }
+
+#if LOLTOML_SIMD_AVX2
+    if (has_avx2()) {
+        return avx2_skip<Class>(begin, end);
+    }
+#endif
+
+#if LOLTOML_SIMD_SSE2
+    return sse2_skip<Class>(begin, end);
+#else
+    while (begin != end && Class::contains(*begin)) {
+        ++begin;
+    }
+
+    return begin;
+#endif
+}
+
+
+} // namespace simd
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_SIMD_HPP
@@ -0,0 +1,54 @@
+#ifndef LOLTOML_DETAIL_STOP_AFTER_KEYS_HPP
+#define LOLTOML_DETAIL_STOP_AFTER_KEYS_HPP
+
+#include "loltoml/detail/callbacks.hpp"
+#include "loltoml/detail/common.hpp"
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+/*
+ * Tracks which of the requested key paths (see parse_options_t::stop_after_keys) have been delivered.
+ * The parser reports table headers and key-value pairs, including pairs of inline tables nested in the values.
+ */
+class stop_after_keys_t {
+public:
+    explicit stop_after_keys_t(const std::vector<std::vector<std::string>> &paths) :
+        m_remaining(paths.begin(), paths.end())
+    { }
+
+    void table(key_iterator_t begin, key_iterator_t end) {
+        m_path.assign(begin, end);
+    }
+
+    void start_value(const char *key, std::size_t size) {
+        m_path.emplace_back(key, size);
+    }
+
+    // Returns true if it was the last of the requested keys.
+    bool finish_value() {
+        bool found = m_remaining.erase(m_path) > 0;
+        m_path.pop_back();
+
+        return found && m_remaining.empty();
+    }
+
+private:
+    std::set<std::vector<std::string>> m_remaining;
+    // The table path followed by keys of the current key-value pair and of the inline tables enclosing it.
+    std::vector<std::string> m_path;
+};
+
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_STOP_AFTER_KEYS_HPP
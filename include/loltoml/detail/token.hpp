@@ -0,0 +1,120 @@
+#ifndef LOLTOML_DETAIL_TOKEN_HPP
+#define LOLTOML_DETAIL_TOKEN_HPP
+
+#include "loltoml/detail/common.hpp"
+
+#include <cstddef>
+#include <string>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+
+/*
+ * Accumulates a token (key, string, comment, symbol) read by the parser.
+ * When the input is a contiguous buffer, the token refers to the source characters until
+ * it's modified (e.g. by an escape-sequence), and only then copies them to the internal storage.
+ * The storage is reused between tokens.
+ *
+ * If nobody needs the contents (e.g. loltoml::validate()), modified tokens may keep referring to the source:
+ * then only their sizes are correct.
+ */
+class token_t {
+public:
+    explicit token_t(bool keep_contents = true) :
+        m_data(nullptr),
+        m_size(0),
+        m_owned(true),
+        m_keep_contents(keep_contents)
+    { }
+
+    // Starts a new token. If source is not null, it must point to the next character of the input.
+    void start(const char *source) {
+        m_storage.clear();
+        m_data = source;
+        m_size = 0;
+        m_owned = (source == nullptr);
+    }
+
+    // Appends a character which is the next unmodified character of the input.
+    void append_source(char ch) {
+        if (m_owned) {
+            m_storage.push_back(ch);
+        } else {
+            ++m_size;
+        }
+    }
+
+    // Appends a run of the next unmodified characters of the input.
+    void append_source(const char *data, std::size_t count) {
+        if (m_owned) {
+            m_storage.append(data, count);
+        } else {
+            m_size += count;
+        }
+    }
+
+    // Appends an arbitrary character.
+    void push_back(char ch) {
+        if (!m_keep_contents && !m_owned) {
+            // Escape-sequences are longer than their values, so the token still lies inside the source.
+            ++m_size;
+            return;
+        }
+
+        materialize();
+        m_storage.push_back(ch);
+    }
+
+    // Must be called before skipping characters of the input in the middle of the token.
+    void materialize() {
+        if (!m_owned) {
+            m_storage.assign(m_data, m_size);
+            m_owned = true;
+        }
+    }
+
+    const char *data() const {
+        return m_owned ? m_storage.data() : m_data;
+    }
+
+    std::size_t size() const {
+        return m_owned ? m_storage.size() : m_size;
+    }
+
+    const std::string &str() {
+        materialize();
+        return m_storage;
+    }
+
+private:
+    const char *m_data;
+    std::size_t m_size;
+    bool m_owned;
+    bool m_keep_contents;
+    std::string m_storage;
+};
+
+
+// Converts a token to the string type requested by the handler.
+template<class String>
+struct token_converter_t {
+    static String convert(token_t &token) {
+        return String(token.data(), token.size());
+    }
+};
+
+template<>
+struct token_converter_t<std::string> {
+    static const std::string &convert(token_t &token) {
+        return token.str();
+    }
+};
+
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_TOKEN_HPP
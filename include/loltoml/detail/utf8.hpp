@@ -0,0 +1,309 @@
+#ifndef LOLTOML_DETAIL_UTF8_HPP
+#define LOLTOML_DETAIL_UTF8_HPP
+
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/simd.hpp"
+
+#include <cstddef>
+
+LOLTOML_OPEN_NAMESPACE
+
+namespace detail {
+
+namespace utf8 {
+
+
+// Returns length of the well-formed sequence starting at the position, or 0 if it's ill-formed.
+inline std::size_t sequence_length(const char *position, const char *end) {
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(position);
+    unsigned char lead = bytes[0];
+
+    if (lead < 0x80) {
+        return 1;
+    }
+
+    std::size_t length;
+    unsigned char min_second = 0x80;
+    unsigned char max_second = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+
+        if (lead == 0xE0) {
+            // Overlong encoding.
+            min_second = 0xA0;
+        } else if (lead == 0xED) {
+            // Surrogates.
+            max_second = 0x9F;
+        }
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+
+        if (lead == 0xF0) {
+            // Overlong encoding.
+            min_second = 0x90;
+        } else if (lead == 0xF4) {
+            // Greater than U+10FFFF.
+            max_second = 0x8F;
+        }
+    } else {
+        return 0;
+    }
+
+    if (static_cast<std::size_t>(end - position) < length || bytes[1] < min_second || bytes[1] > max_second) {
+        return 0;
+    }
+
+    for (std::size_t i = 2; i < length; ++i) {
+        if ((bytes[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+
+    return length;
+}
+
+
+// Returns pointer to the first byte of the first ill-formed sequence in [begin, end), or end if there is none.
+inline const char *scalar_validate(const char *begin, const char *end) {
+    while (begin != end) {
+        std::size_t length = sequence_length(begin, end);
+
+        if (length == 0) {
+            return begin;
+        }
+
+        begin += length;
+    }
+
+    return end;
+}
+
+
+// Returns the start of the last (possibly incomplete) character before the position,
+// so that the scalar validator can continue from there.
+inline const char *last_character_start(const char *begin, const char *position) {
+    if (position == begin) {
+        return position;
+    }
+
+    --position;
+
+    for (int i = 0; i < 3 && position != begin && (static_cast<unsigned char>(*position) & 0xC0) == 0x80; ++i) {
+        --position;
+    }
+
+    return position;
+}
+
+
+#if LOLTOML_SIMD_AVX2
+
+/*
+ * Vectorized validation from "Validating UTF-8 In Less Than One Instruction Per Byte" by John Keiser and Daniel Lemire.
+ * Each byte is classified by looking up its high nibble, the low and high nibbles of the previous byte in three tables.
+ * The tables are arranged so that the AND of the results is non-zero only for invalid two-byte combinations.
+ * Missing and unexpected third and fourth continuation bytes are checked separately.
+ */
+
+const unsigned char too_short = 1 << 0;      // 11______ 0_______ or 11______ 11______
+const unsigned char too_long = 1 << 1;       // 0_______ 10______
+const unsigned char overlong_3 = 1 << 2;     // 11100000 100_____
+const unsigned char too_large = 1 << 3;      // 11110100 1001____, 11110100 101_____, 11110101+ 1_______
+const unsigned char surrogate = 1 << 4;      // 11101101 101_____
+const unsigned char overlong_2 = 1 << 5;     // 1100000_ 10______
+const unsigned char too_large_1000 = 1 << 6; // 11110101+ 1000____
+const unsigned char overlong_4 = 1 << 6;     // 11110000 1000____
+const unsigned char two_conts = 1 << 7;      // 10______ 10______
+const unsigned char carry = too_short | too_long | two_conts;
+
+__attribute__((target("avx2")))
+inline __m256i lookup16(__m256i nibbles, __m256i table) {
+    return _mm256_shuffle_epi8(table, nibbles);
+}
+
+__attribute__((target("avx2")))
+inline __m256i table16(unsigned char t0, unsigned char t1, unsigned char t2, unsigned char t3,
+                       unsigned char t4, unsigned char t5, unsigned char t6, unsigned char t7,
+                       unsigned char t8, unsigned char t9, unsigned char t10, unsigned char t11,
+                       unsigned char t12, unsigned char t13, unsigned char t14, unsigned char t15)
+{
+    return _mm256_setr_epi8(
+        t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15,
+        t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15
+    );
+}
+
+// Bytes of `input` shifted by N positions, with the last bytes of `previous` shifted in.
+template<int N>
+__attribute__((target("avx2")))
+inline __m256i previous_bytes(__m256i input, __m256i previous) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+}
+
+__attribute__((target("avx2")))
+inline __m256i high_nibbles(__m256i bytes) {
+    return _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0F));
+}
+
+__attribute__((target("avx2")))
+inline __m256i check_block(__m256i input, __m256i previous) {
+    __m256i previous1 = previous_bytes<1>(input, previous);
+
+    __m256i byte_1_high = lookup16(high_nibbles(previous1), table16(
+        too_long, too_long, too_long, too_long,
+        too_long, too_long, too_long, too_long,
+        two_conts, two_conts, two_conts, two_conts,
+        too_short | overlong_2,
+        too_short,
+        too_short | overlong_3 | surrogate,
+        too_short | too_large | too_large_1000 | overlong_4
+    ));
+
+    __m256i byte_1_low = lookup16(_mm256_and_si256(previous1, _mm256_set1_epi8(0x0F)), table16(
+        carry | overlong_3 | overlong_2 | overlong_4,
+        carry | overlong_2,
+        carry,
+        carry,
+        carry | too_large,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000 | surrogate,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000
+    ));
+
+    __m256i byte_2_high = lookup16(high_nibbles(input), table16(
+        too_short, too_short, too_short, too_short,
+        too_short, too_short, too_short, too_short,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_short, too_short, too_short, too_short
+    ));
+
+    __m256i special_cases = _mm256_and_si256(byte_1_high, _mm256_and_si256(byte_1_low, byte_2_high));
+
+    // Third and fourth bytes of 3- and 4-byte sequences must be continuations (and only they may follow a continuation).
+    __m256i is_third_byte = _mm256_subs_epu8(previous_bytes<2>(input, previous), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m256i is_fourth_byte = _mm256_subs_epu8(previous_bytes<3>(input, previous), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+    return _mm256_xor_si256(must_be_continuation, special_cases);
+}
+
+// Non-zero if the block ends with an incomplete multi-byte sequence.
+__attribute__((target("avx2")))
+inline __m256i incomplete_tail(__m256i input) {
+    const __m256i max_value = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1)
+    );
+
+    return _mm256_subs_epu8(input, max_value);
+}
+
+// Returns pointer to a position from which the scalar validator must continue.
+// Everything before the position is valid.
+__attribute__((target("avx2")))
+inline const char *avx2_validate(const char *begin, const char *end) {
+    const char *current = begin;
+    __m256i previous = _mm256_setzero_si256();
+    __m256i previous_incomplete = _mm256_setzero_si256();
+
+    while (end - current >= 32) {
+        __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(current));
+        __m256i error;
+
+        if (_mm256_movemask_epi8(input) == 0) {
+            // Only ASCII, but the previous block could end with an incomplete sequence.
+            error = previous_incomplete;
+            previous_incomplete = _mm256_setzero_si256();
+        } else {
+            error = check_block(input, previous);
+            previous_incomplete = incomplete_tail(input);
+        }
+
+        if (!_mm256_testz_si256(error, error)) {
+            return last_character_start(begin, current);
+        }
+
+        previous = input;
+        current += 32;
+    }
+
+    return last_character_start(begin, current);
+}
+
+#endif // LOLTOML_SIMD_AVX2
+
+
+#if LOLTOML_SIMD_SSE2
+
+// Skips ASCII characters 16 at a time.
+inline const char *sse2_skip_ascii(const char *begin, const char *end) {
+    while (end - begin >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        int mask = _mm_movemask_epi8(block);
+
+        if (mask != 0) {
+            return begin + simd::count_trailing_zeros(static_cast<unsigned int>(mask));
+        }
+
+        begin += 16;
+    }
+
+    return begin;
+}
+
+#endif // LOLTOML_SIMD_SSE2
+
+
+// Returns pointer to the first byte of the first ill-formed sequence in [begin, end), or end if there is none.
+inline const char *validate(const char *begin, const char *end) {
+#if LOLTOML_SIMD_AVX2
+    if (simd::has_avx2()) {
+        return scalar_validate(avx2_validate(begin, end), end);
+    }
+#endif
+
+#if LOLTOML_SIMD_SSE2
+    // Configs are mostly ASCII: skip it with SSE2 and check the other characters one by one.
+    while (true) {
+        begin = sse2_skip_ascii(begin, end);
+
+        if (begin == end) {
+            return end;
+        }
+
+        std::size_t length = sequence_length(begin, end);
+
+        if (length == 0) {
+            return begin;
+        }
+
+        begin += length;
+    }
+#else
+    return scalar_validate(begin, end);
+#endif
+}
+
+
+} // namespace utf8
+
+} // namespace detail
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DETAIL_UTF8_HPP
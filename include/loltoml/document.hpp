@@ -0,0 +1,545 @@
+#ifndef LOLTOML_DOCUMENT_HPP
+#define LOLTOML_DOCUMENT_HPP
+
+#include "loltoml/detail/arena.hpp"
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/hash.hpp"
+#include "loltoml/error.hpp"
+#include "loltoml/parse.hpp"
+#include "loltoml/parse_options.hpp"
+#include "loltoml/string_ref.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+LOLTOML_OPEN_NAMESPACE
+
+
+//! Types of values of loltoml::value_t.
+enum class value_type_t : std::uint8_t {
+    // A value-initialized value_t is an empty table.
+    table,
+    array,
+    string,
+    integer,
+    floating_point,
+    boolean,
+    datetime,
+    symbol
+};
+
+
+struct member_t;
+class member_iterator_t;
+
+
+/*! Node of loltoml::document_t.
+ *
+ * Nodes are owned by the document and are valid until it's destroyed or cleared.
+ * Accessors of a type must only be called on values of this type.
+ */
+class value_t {
+public:
+    value_type_t type() const {
+        return m_type;
+    }
+
+    bool as_boolean() const {
+        assert(m_type == value_type_t::boolean);
+        return m_data.boolean;
+    }
+
+    std::int64_t as_integer() const {
+        assert(m_type == value_type_t::integer);
+        return m_data.integer;
+    }
+
+    double as_floating_point() const {
+        assert(m_type == value_type_t::floating_point);
+        return m_data.floating_point;
+    }
+
+    //! Value of a string, a datetime or a symbol.
+    string_ref_t as_string() const {
+        assert(m_type == value_type_t::string || m_type == value_type_t::datetime || m_type == value_type_t::symbol);
+        return string_ref_t(m_data.string.data, m_data.string.size);
+    }
+
+    //! Number of members of a table or elements of an array.
+    std::size_t size() const {
+        assert(m_type == value_type_t::table || m_type == value_type_t::array);
+        return m_data.children.size;
+    }
+
+    /*! Members of a table or elements of an array, in order of their appearance in the document.
+     *
+     * Keys of array elements are empty.
+     */
+    member_iterator_t begin() const;
+    member_iterator_t end() const;
+
+    //! \returns Value of the key in a table, or nullptr if there is no such key.
+    const value_t *find(string_ref_t key) const;
+
+private:
+    friend class document_t;
+    friend class document_builder_t;
+
+    enum flags_t : std::uint8_t {
+        // Table is defined by a header ([a] or [[a]]).
+        defined_table = 1,
+        // Table or array can't be extended by headers, i.e. it's an inline table or an array value.
+        static_value = 2,
+        // Array is created by [[a]] headers.
+        table_array = 4
+    };
+
+    struct string_data_t {
+        const char *data;
+        std::size_t size;
+    };
+
+    // Tables with more than a few members are indexed by an open-addressing hash table of index_mask + 1 slots.
+    struct children_data_t {
+        member_t *first;
+        member_t *last;
+        std::size_t size;
+        member_t **index;
+        std::size_t index_mask;
+    };
+
+    union data_t {
+        bool boolean;
+        std::int64_t integer;
+        double floating_point;
+        string_data_t string;
+        children_data_t children;
+    };
+
+    member_t *find_member(string_ref_t key) const;
+
+private:
+    value_type_t m_type;
+    std::uint8_t m_flags;
+    data_t m_data;
+};
+
+
+//! Member of a table or element of an array.
+struct member_t {
+    string_ref_t key;
+    value_t value;
+    member_t *next;
+};
+
+
+//! Forward iterator over members of a table or elements of an array.
+class member_iterator_t {
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef member_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const member_t *pointer;
+    typedef const member_t &reference;
+
+    member_iterator_t() :
+        m_member(nullptr)
+    { }
+
+    explicit member_iterator_t(const member_t *member) :
+        m_member(member)
+    { }
+
+    reference operator*() const {
+        return *m_member;
+    }
+
+    pointer operator->() const {
+        return m_member;
+    }
+
+    member_iterator_t &operator++() {
+        m_member = m_member->next;
+        return *this;
+    }
+
+    member_iterator_t operator++(int) {
+        member_iterator_t result = *this;
+        m_member = m_member->next;
+        return result;
+    }
+
+    bool operator==(const member_iterator_t &other) const {
+        return m_member == other.m_member;
+    }
+
+    bool operator!=(const member_iterator_t &other) const {
+        return m_member != other.m_member;
+    }
+
+private:
+    const member_t *m_member;
+};
+
+
+inline member_iterator_t value_t::begin() const {
+    assert(m_type == value_type_t::table || m_type == value_type_t::array);
+    return member_iterator_t(m_data.children.first);
+}
+
+inline member_iterator_t value_t::end() const {
+    return member_iterator_t();
+}
+
+inline const value_t *value_t::find(string_ref_t key) const {
+    const member_t *member = find_member(key);
+    return member ? &member->value : nullptr;
+}
+
+
+inline member_t *value_t::find_member(string_ref_t key) const {
+    assert(m_type == value_type_t::table);
+    const children_data_t &children = m_data.children;
+
+    if (children.index) {
+        for (std::size_t i = detail::hash_bytes(key.data(), key.size()) & children.index_mask; children.index[i]; i = (i + 1) & children.index_mask) {
+            if (children.index[i]->key == key) {
+                return children.index[i];
+            }
+        }
+    } else {
+        for (member_t *member = children.first; member; member = member->next) {
+            if (member->key == key) {
+                return member;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+
+/*! DOM of a TOML document.
+ *
+ * All nodes, keys and strings are allocated in an arena owned by the document,
+ * so the whole document is freed at once. Documents are movable but not copyable.
+ * A default-constructed document has an empty root table.
+ */
+class document_t {
+public:
+    document_t() :
+        m_root()
+    { }
+
+    document_t(document_t &&other) :
+        m_arena(std::move(other.m_arena)),
+        m_root(other.m_root)
+    {
+        other.m_root = value_t();
+    }
+
+    document_t &operator=(document_t &&other) {
+        if (this != &other) {
+            m_arena = std::move(other.m_arena);
+            m_root = other.m_root;
+            other.m_root = value_t();
+        }
+
+        return *this;
+    }
+
+    document_t(const document_t &) = delete;
+    document_t &operator=(const document_t &) = delete;
+
+    //! The root table.
+    const value_t &root() const {
+        return m_root;
+    }
+
+    //! Shortcut for root().find(key).
+    const value_t *find(string_ref_t key) const {
+        return m_root.find(key);
+    }
+
+    //! Releases all the memory and makes the root table empty.
+    void clear() {
+        m_arena.release();
+        m_root = value_t();
+    }
+
+    //! Bytes allocated by the document for its nodes, keys and strings.
+    std::size_t memory_usage() const {
+        return m_arena.allocated();
+    }
+
+private:
+    friend class document_builder_t;
+
+    detail::arena_t m_arena;
+    value_t m_root;
+};
+
+
+/*! SAX-handler building a loltoml::document_t.
+ *
+ * It may be passed to any parsing function (loltoml::parse(), loltoml::parse_file(), loltoml::incremental_parser_t etc.).
+ * The document is cleared at start_document().
+ * Besides the checks of the parser, it rejects documents defining a key or a table twice
+ * with loltoml::document_error_t.
+ */
+class document_builder_t {
+public:
+    typedef string_ref_t string_type;
+
+    explicit document_builder_t(document_t &document) :
+        m_document(document)
+    { }
+
+    void start_document() {
+        m_document.clear();
+        m_stack.assign(1, &m_document.m_root);
+    }
+
+    void table(key_iterator_t begin, key_iterator_t end) {
+        value_t *current = &m_document.m_root;
+
+        for (key_iterator_t next = std::next(begin); next != end; begin = next++) {
+            current = open_table(current, *begin);
+        }
+
+        member_t *member = current->find_member(*begin);
+
+        if (!member) {
+            member = append_member(current, copy(*begin));
+        } else if (member->value.m_type != value_type_t::table || (member->value.m_flags & (value_t::defined_table | value_t::static_value))) {
+            throw document_error_t("Table \"" + *begin + "\" is defined twice");
+        }
+
+        member->value.m_flags |= value_t::defined_table;
+        m_stack.assign(1, &member->value);
+    }
+
+    void array_table(key_iterator_t begin, key_iterator_t end) {
+        value_t *current = &m_document.m_root;
+
+        for (key_iterator_t next = std::next(begin); next != end; begin = next++) {
+            current = open_table(current, *begin);
+        }
+
+        member_t *member = current->find_member(*begin);
+
+        if (!member) {
+            member = append_member(current, copy(*begin));
+            member->value.m_type = value_type_t::array;
+            member->value.m_flags = value_t::table_array;
+        } else if (!(member->value.m_flags & value_t::table_array)) {
+            throw document_error_t("Key \"" + *begin + "\" is already defined and isn't an array of tables");
+        }
+
+        member_t *item = append_member(&member->value, string_ref_t());
+        item->value.m_flags = value_t::defined_table;
+        m_stack.assign(1, &item->value);
+    }
+
+    void key(string_ref_t value) {
+        m_key = copy(value);
+    }
+
+    void start_array() {
+        value_t *value = add_value(value_type_t::array);
+        value->m_flags = value_t::static_value;
+        m_stack.push_back(value);
+    }
+
+    void finish_array(std::size_t) {
+        m_stack.pop_back();
+    }
+
+    void start_inline_table() {
+        value_t *value = add_value(value_type_t::table);
+        value->m_flags = value_t::static_value;
+        m_stack.push_back(value);
+    }
+
+    void finish_inline_table(std::size_t) {
+        m_stack.pop_back();
+    }
+
+    void boolean(bool value) {
+        add_value(value_type_t::boolean)->m_data.boolean = value;
+    }
+
+    void string(string_ref_t value) {
+        add_string(value_type_t::string, value);
+    }
+
+    void datetime(string_ref_t value) {
+        add_string(value_type_t::datetime, value);
+    }
+
+    void integer(std::int64_t value) {
+        add_value(value_type_t::integer)->m_data.integer = value;
+    }
+
+    void floating_point(double value) {
+        add_value(value_type_t::floating_point)->m_data.floating_point = value;
+    }
+
+    void symbol(string_ref_t value) {
+        add_string(value_type_t::symbol, value);
+    }
+
+private:
+    // Smaller tables are searched linearly.
+    static const std::size_t max_unindexed_size = 8;
+
+    string_ref_t copy(string_ref_t value) {
+        return string_ref_t(m_document.m_arena.copy(value.data(), value.size()), value.size());
+    }
+
+    // Finds a table on the path of a header. Missing tables are created, arrays of tables lead to their last element.
+    value_t *open_table(value_t *parent, const std::string &key) {
+        member_t *member = parent->find_member(key);
+
+        if (!member) {
+            return &append_member(parent, copy(key))->value;
+        }
+
+        value_t *value = &member->value;
+
+        if (value->m_type == value_type_t::table && !(value->m_flags & value_t::static_value)) {
+            return value;
+        } else if (value->m_flags & value_t::table_array) {
+            return &value->m_data.children.last->value;
+        }
+
+        throw document_error_t("Key \"" + key + "\" is already defined and isn't a table");
+    }
+
+    // Appends a member to a table or an element to an array. The new value is an empty table.
+    member_t *append_member(value_t *parent, string_ref_t key) {
+        member_t *member = m_document.m_arena.create<member_t>();
+        member->key = key;
+
+        value_t::children_data_t &children = parent->m_data.children;
+
+        if (children.last) {
+            children.last->next = member;
+        } else {
+            children.first = member;
+        }
+
+        children.last = member;
+        ++children.size;
+
+        if (parent->m_type == value_type_t::table) {
+            if (children.index && children.size * 2 <= children.index_mask + 1) {
+                insert_into_index(children, member);
+            } else if (children.index || children.size > max_unindexed_size) {
+                rebuild_index(children);
+            }
+        }
+
+        return member;
+    }
+
+    void insert_into_index(value_t::children_data_t &children, member_t *member) {
+        std::size_t i = detail::hash_bytes(member->key.data(), member->key.size()) & children.index_mask;
+
+        while (children.index[i]) {
+            i = (i + 1) & children.index_mask;
+        }
+
+        children.index[i] = member;
+    }
+
+    // Old indices are left in the arena, they take less space than the final one.
+    void rebuild_index(value_t::children_data_t &children) {
+        std::size_t slots = children.index ? 2 * (children.index_mask + 1) : 4 * max_unindexed_size;
+
+        children.index = m_document.m_arena.create_array<member_t *>(slots);
+        children.index_mask = slots - 1;
+        std::fill(children.index, children.index + slots, nullptr);
+
+        for (member_t *member = children.first; member; member = member->next) {
+            insert_into_index(children, member);
+        }
+    }
+
+    value_t *add_value(value_type_t type) {
+        value_t *parent = m_stack.back();
+        member_t *member;
+
+        if (parent->m_type == value_type_t::table) {
+            if (parent->find_member(m_key)) {
+                throw document_error_t("Key \"" + m_key.str() + "\" is defined twice");
+            }
+
+            member = append_member(parent, m_key);
+        } else {
+            member = append_member(parent, string_ref_t());
+        }
+
+        member->value.m_type = type;
+        return &member->value;
+    }
+
+    void add_string(value_type_t type, string_ref_t value) {
+        string_ref_t copied = copy(value);
+        value_t::string_data_t &data = add_value(type)->m_data.string;
+        data.data = copied.data();
+        data.size = copied.size();
+    }
+
+private:
+    document_t &m_document;
+    // Innermost container is at the back.
+    std::vector<value_t *> m_stack;
+    // Key of the current key-value pair, copied to the arena.
+    string_ref_t m_key;
+};
+
+
+/*! Parse a TOML document from a buffer into a loltoml::document_t.
+ *
+ * The document doesn't refer to the buffer.
+ *
+ * \param[in] begin Pointer to the first byte of the document. It must be utf-8 encoded.
+ * \param[in] end Pointer past the last byte of the document.
+ * \param[in] options Features to enable, see loltoml::parse_options_t.
+ * \throws loltoml::parser_error_t if the buffer contains an invalid TOML document.
+ * \throws loltoml::document_error_t if the document defines a key or a table twice.
+ */
+inline document_t parse_document(const char *begin, const char *end, const parse_options_t &options = parse_options_t()) {
+    document_t document;
+    document_builder_t builder(document);
+    parse(begin, end, builder, options);
+    return document;
+}
+
+
+/*! Parse a TOML document from a stream into a loltoml::document_t.
+ *
+ * \param[in, out] input Stream containing a TOML document. It must be utf-8 encoded.
+ * \param[in] options Features to enable, see loltoml::parse_options_t.
+ * \throws loltoml::parser_error_t if the input contains an invalid TOML document.
+ * \throws loltoml::document_error_t if the document defines a key or a table twice.
+ * \throws loltoml::stream_error_t if input.bad() becomes true.
+ */
+inline document_t parse_document(std::istream &input, const parse_options_t &options = parse_options_t()) {
+    document_t document;
+    document_builder_t builder(document);
+    parse(input, builder, options);
+    return document;
+}
+
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_DOCUMENT_HPP
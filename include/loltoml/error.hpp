@@ -65,6 +65,76 @@ public:
     }
 };
 
+//! Thrown by loltoml::parse_file() when it's unable to open or map the file.
+class file_error_t :
+    public parser_error_t
+{
+public:
+    /*!
+     * \param[in] message Message describing the error.
+     * \throws std::bad_alloc
+     */
+    explicit file_error_t(std::string message) :
+        parser_error_t(std::move(message), 0)
+    { }
+
+    virtual ~file_error_t() throw() { }
+
+    virtual const char *what() const throw() {
+        return "loltoml file error";
+    }
+};
+
+/*! Thrown by loltoml::document_builder_t when a syntactically valid document defines a key or a table twice,
+ *  or defines a table through a key holding a value of another type,
+ *  and by loltoml::tape_document_t::read() for snapshots which aren't well-formed tapes.
+ *
+ * The builder only sees the events, so the offset is always 0.
+ */
+class document_error_t :
+    public parser_error_t
+{
+public:
+    /*!
+     * \param[in] message Message describing the error.
+     * \throws std::bad_alloc
+     */
+    explicit document_error_t(std::string message) :
+        parser_error_t(std::move(message), 0)
+    { }
+
+    virtual ~document_error_t() throw() { }
+
+    virtual const char *what() const throw() {
+        return "loltoml document error";
+    }
+};
+
+/*! Thrown by loltoml::parse_into() when a value doesn't fit the field it's bound to,
+ *  e.g. a string is assigned to an integer field or an integer is out of the range of its field.
+ *
+ * Like loltoml::document_error_t, its offset is always 0.
+ */
+class bind_error_t :
+    public parser_error_t
+{
+public:
+    /*!
+     * \param[in] message Message describing the error.
+     * \throws std::bad_alloc
+     */
+    explicit bind_error_t(std::string message) :
+        parser_error_t(std::move(message), 0)
+    { }
+
+    virtual ~bind_error_t() throw() { }
+
+    virtual const char *what() const throw() {
+        return "loltoml bind error";
+    }
+};
+
+
 
 LOLTOML_CLOSE_NAMESPACE
 
@@ -0,0 +1,180 @@
+#ifndef LOLTOML_INCREMENTAL_PARSER_HPP
+#define LOLTOML_INCREMENTAL_PARSER_HPP
+
+#include "loltoml/detail/callbacks.hpp"
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/expression_scanner.hpp"
+#include "loltoml/detail/input_buffer.hpp"
+#include "loltoml/detail/parser.hpp"
+#include "loltoml/error.hpp"
+
+#include <cstddef>
+#include <string>
+
+LOLTOML_OPEN_NAMESPACE
+
+
+/*! Push-style parser for documents arriving in pieces, e.g. from a pipe or a socket.
+ *
+ * Feeds the handler with the same events as loltoml::parse() (see it for requirements to the handler)
+ * as soon as each top-level expression (key-value pair, table header, comment) is complete.
+ * Only the incomplete expression at the end of each piece is copied and kept between calls,
+ * so memory usage doesn't depend on the size of the document.
+ *
+ * Errors are reported by feed() or finish() with offsets relative to the start of the document.
+ * After an error the parser must not be used anymore.
+ *
+ * If the handler returns loltoml::action_t::stop, the rest of the input is ignored (see stopped()).
+ *
+ * \tparam Handler Type of the handler.
+ */
+template<class Handler>
+class incremental_parser_t {
+public:
+    //! \param[out] handler Parser will feed SAX-events to this object.
+    explicit incremental_parser_t(Handler &handler) :
+        m_handler(handler),
+        m_started(false),
+        m_stopped(false),
+        m_skipping_section(false),
+        m_offset(0),
+        m_scanned(0)
+    { }
+
+    /*! Parse the next piece of the document.
+     *
+     * \param[in] data Pointer to the piece. It isn't used after the function returns.
+     * \param[in] size Size of the piece.
+     * \throws loltoml::parser_error_t if the document is invalid.
+     */
+    void feed(const char *data, std::size_t size) {
+        try {
+            start();
+            parse_piece(data, size);
+        } catch (const detail::stop_parsing_t &) {
+            stop();
+        }
+    }
+
+    /*! Parse the rest of the document. Must be called after the last piece.
+     *
+     * \throws loltoml::parser_error_t if the document is invalid.
+     */
+    void finish() {
+        try {
+            start();
+            parse_expressions(m_buffer.data(), m_buffer.size());
+        } catch (const detail::stop_parsing_t &) {
+            // The document is finished as is.
+        }
+
+        stop();
+        detail::callbacks_t<Handler>(m_handler).finish_document();
+    }
+
+    //! \returns true if the handler asked to stop parsing, so there is no need to feed the rest of the document.
+    bool stopped() const {
+        return m_stopped;
+    }
+
+private:
+    void start() {
+        if (!m_started) {
+            m_started = true;
+            detail::callbacks_t<Handler>(m_handler).start_document();
+        }
+    }
+
+    void stop() {
+        m_stopped = true;
+        m_buffer.clear();
+        m_scanned = 0;
+    }
+
+    void parse_piece(const char *data, std::size_t size) {
+        if (m_stopped) {
+            return;
+        }
+
+        const char *current = data;
+        const char *end = data + size;
+
+        if (!m_buffer.empty()) {
+            // Scanning needs contiguous data to look ahead, so the piece is appended to the incomplete expression.
+            std::size_t buffered = m_buffer.size();
+            m_buffer.append(data, size);
+
+            detail::expression_scanner_t::result_t result =
+                m_scanner.scan(m_buffer.data() + m_scanned, m_buffer.data() + m_buffer.size());
+
+            if (!result.complete) {
+                m_scanned = static_cast<std::size_t>(result.position - m_buffer.data());
+                return;
+            }
+
+            std::size_t expression_size = static_cast<std::size_t>(result.position - m_buffer.data());
+            parse_expressions(m_buffer.data(), expression_size);
+
+            current = data + (expression_size - buffered);
+            m_buffer.clear();
+            m_scanned = 0;
+        }
+
+        // Parse all complete expressions right from the piece.
+        const char *complete_end = current;
+
+        while (complete_end != end) {
+            detail::expression_scanner_t::result_t result = m_scanner.scan(complete_end, end);
+
+            if (!result.complete) {
+                m_buffer.assign(complete_end, end);
+                m_scanned = static_cast<std::size_t>(result.position - complete_end);
+                break;
+            }
+
+            complete_end = result.position;
+        }
+
+        parse_expressions(current, static_cast<std::size_t>(complete_end - current));
+    }
+
+    void parse_expressions(const char *begin, std::size_t size) {
+        if (size == 0) {
+            return;
+        }
+
+        detail::parser_t<Handler, detail::input_buffer_t> parser(detail::input_buffer_t(begin, begin + size), m_handler);
+        parser.set_skipping(m_skipping_section);
+
+        try {
+            parser.parse_expressions();
+        } catch (const detail::stop_parsing_t &) {
+            parser.close_containers();
+            throw;
+        } catch (const parser_error_t &e) {
+            throw parser_error_t(e.message(), m_offset + e.offset());
+        }
+
+        m_skipping_section = parser.skipping();
+        m_offset += size;
+    }
+
+private:
+    Handler &m_handler;
+    bool m_started;
+    bool m_stopped;
+    // True if the handler asked to skip the [table] section of the last parsed header.
+    bool m_skipping_section;
+    // Offset of the first unparsed character in the document.
+    std::size_t m_offset;
+    // The incomplete expression at the end of the previous pieces.
+    std::string m_buffer;
+    // Position in m_buffer where the scanner stopped.
+    std::size_t m_scanned;
+    detail::expression_scanner_t m_scanner;
+};
+
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_INCREMENTAL_PARSER_HPP
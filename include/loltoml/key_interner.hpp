@@ -0,0 +1,134 @@
+#ifndef LOLTOML_KEY_INTERNER_HPP
+#define LOLTOML_KEY_INTERNER_HPP
+
+#include "loltoml/detail/arena.hpp"
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/hash.hpp"
+#include "loltoml/string_ref.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+LOLTOML_OPEN_NAMESPACE
+
+
+/*! Key delivered by the parser to handlers accepting it (see loltoml::parse_options_t::key_interner).
+ *
+ * Equal keys have equal ids, so handlers can dispatch on the id instead of comparing strings.
+ */
+struct interned_key_t {
+    //! Index of the key in the interner, ids are given in order from 0.
+    std::uint32_t id;
+    //! Characters of the key, owned by the interner.
+    string_ref_t name;
+};
+
+
+/*! Maps keys to stable ids and copies of their characters.
+ *
+ * A key is copied the first time it's seen, later lookups of it allocate nothing,
+ * so an interner shared by many parses of documents with the same keys stops allocating after the first one.
+ * Ids and names stay valid until the interner is destroyed, the memory grows with the number of distinct keys.
+ * Interners are movable but not copyable, and aren't safe to use from several threads at once.
+ */
+class key_interner_t {
+public:
+    key_interner_t() :
+        m_slots(16, 0)
+    { }
+
+    //! \returns The key, which is added if it's new.
+    interned_key_t intern(string_ref_t key) {
+        std::size_t hash = detail::hash_bytes(key.data(), key.size());
+        std::size_t mask = m_slots.size() - 1;
+
+        for (std::size_t i = hash & mask; m_slots[i] != 0; i = (i + 1) & mask) {
+            const entry_t &entry = m_entries[m_slots[i] - 1];
+
+            if (entry.hash == hash && entry.name == key) {
+                interned_key_t result = { m_slots[i] - 1, entry.name };
+                return result;
+            }
+        }
+
+        entry_t entry = { hash, string_ref_t(m_storage.copy(key.data(), key.size()), key.size()) };
+        m_entries.push_back(entry);
+
+        if (m_entries.size() * 2 > m_slots.size()) {
+            rehash(m_slots.size() * 2);
+        } else {
+            insert(m_entries.size() - 1);
+        }
+
+        interned_key_t result = { static_cast<std::uint32_t>(m_entries.size() - 1), entry.name };
+        return result;
+    }
+
+    //! \returns Id of the key, or npos if it was never interned.
+    std::uint32_t find(string_ref_t key) const {
+        std::size_t hash = detail::hash_bytes(key.data(), key.size());
+        std::size_t mask = m_slots.size() - 1;
+
+        for (std::size_t i = hash & mask; m_slots[i] != 0; i = (i + 1) & mask) {
+            const entry_t &entry = m_entries[m_slots[i] - 1];
+
+            if (entry.hash == hash && entry.name == key) {
+                return m_slots[i] - 1;
+            }
+        }
+
+        return npos;
+    }
+
+    //! \returns Characters of the key with the id.
+    string_ref_t name(std::uint32_t id) const {
+        return m_entries[id].name;
+    }
+
+    //! \returns Number of distinct keys.
+    std::size_t size() const {
+        return m_entries.size();
+    }
+
+    //! Returned by find() for unknown keys.
+    enum : std::uint32_t { npos = 0xFFFFFFFF };
+
+private:
+    struct entry_t {
+        std::size_t hash;
+        string_ref_t name;
+    };
+
+    void insert(std::size_t id) {
+        std::size_t mask = m_slots.size() - 1;
+        std::size_t i = m_entries[id].hash & mask;
+
+        while (m_slots[i] != 0) {
+            i = (i + 1) & mask;
+        }
+
+        m_slots[i] = static_cast<std::uint32_t>(id + 1);
+    }
+
+    void rehash(std::size_t slots) {
+        m_slots.assign(slots, 0);
+
+        for (std::size_t id = 0; id < m_entries.size(); ++id) {
+            insert(id);
+        }
+    }
+
+private:
+    std::vector<entry_t> m_entries;
+    // Characters of the keys, the arena never moves them.
+    detail::arena_t m_storage;
+    // Id + 1 of the key, 0 if the slot is empty.
+    std::vector<std::uint32_t> m_slots;
+};
+
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_KEY_INTERNER_HPP
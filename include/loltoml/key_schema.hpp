@@ -0,0 +1,263 @@
+#ifndef LOLTOML_KEY_SCHEMA_HPP
+#define LOLTOML_KEY_SCHEMA_HPP
+
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/hash.hpp"
+#include "loltoml/string_ref.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+LOLTOML_OPEN_NAMESPACE
+
+
+/*! Key delivered by the parser to handlers accepting it (see loltoml::parse_options_t::key_schema).
+ *
+ * Handlers of a known schema can switch on the index instead of comparing strings.
+ */
+struct schema_key_t {
+    //! Index of the path of the key in the schema, or loltoml::key_schema_t::npos if the schema doesn't list it.
+    std::uint32_t index;
+    //! Characters of the key itself (not of the path). They are valid only until the handler returns.
+    string_ref_t name;
+};
+
+
+/*! A fixed list of key paths with a minimal perfect hash over them.
+ *
+ * A path is the keys of the table header and the key joined with dots: "title" for a key before the first header,
+ * "server.port" for `port` in `[server]` and "servers.host" for `host` in `[[servers]]`.
+ * Keys of inline tables are addressed through the enclosing keys, "owner.name" for `owner = { name = "x" }`,
+ * and arrays add nothing to the path (the same rules as for loltoml::parse_options_t::stop_after_keys).
+ * Keys containing dots can't be told apart from paths.
+ *
+ * The index of a path is its position in the list, so the list may be a constexpr array
+ * whose indices are also used in case labels through loltoml::key_index().
+ * The paths are hashed into buckets, and every bucket gets a displacement which moves its paths to free slots
+ * of a table with one slot per path. A lookup hashes the path once and compares it with a single slot.
+ * Schemas are immutable once built, so a single schema may be shared by any number of parses and threads.
+ */
+class key_schema_t {
+public:
+    //! Index of paths missing from the schema.
+    enum : std::uint32_t { npos = 0xFFFFFFFF };
+
+    /*!
+     * \param[in] paths Key paths, their indices are their positions in the array.
+     * \throws std::invalid_argument if a path is listed twice.
+     */
+    template<std::size_t N>
+    explicit key_schema_t(const char *const (&paths)[N]) {
+        build(paths, paths + N);
+    }
+
+    /*!
+     * \param[in] paths Key paths, their indices are their positions in the vector.
+     * \throws std::invalid_argument if a path is listed twice.
+     */
+    explicit key_schema_t(const std::vector<std::string> &paths) {
+        build(paths.begin(), paths.end());
+    }
+
+    //! \returns Index of the path, or npos if the schema doesn't list it.
+    std::uint32_t find(string_ref_t path) const {
+        return find(detail::hash_append(detail::hash_basis, path.data(), path.size()), path);
+    }
+
+    //! Same as find(path) for a path hashed by the caller with detail::hash_append().
+    std::uint32_t find(std::uint64_t hash, string_ref_t path) const {
+        if (m_slots.empty()) {
+            return npos;
+        }
+
+        std::uint32_t displacement = m_displacements[reduce(hash, m_displacements.size())];
+        const slot_t &slot = m_slots[slot_position(hash, displacement)];
+
+        if (slot.hash == hash && string_ref_t(m_paths[slot.index]) == path) {
+            return slot.index;
+        }
+
+        return npos;
+    }
+
+    //! \returns Path with the index.
+    string_ref_t path(std::uint32_t index) const {
+        return m_paths[index];
+    }
+
+    //! \returns Number of the paths.
+    std::uint32_t size() const {
+        return static_cast<std::uint32_t>(m_paths.size());
+    }
+
+private:
+    struct slot_t {
+        std::uint64_t hash;
+        std::uint32_t index;
+    };
+
+    // Bucket sizes average to 4, then almost all displacements are found in a few tries.
+    static const std::size_t bucket_load = 4;
+    // Displacements tried for a bucket before the buckets are split further.
+    static const std::uint32_t max_displacement = 1 << 20;
+
+    // Maps high bits of the value to [0, size) without a division.
+    static std::size_t reduce(std::uint64_t value, std::size_t size) {
+        return static_cast<std::size_t>(((value >> 32) * size) >> 32);
+    }
+
+    std::size_t slot_position(std::uint64_t hash, std::uint32_t displacement) const {
+        return reduce(detail::hash_integer(hash ^ displacement), m_slots.size());
+    }
+
+    template<class Iterator>
+    void build(Iterator begin, Iterator end) {
+        for (; begin != end; ++begin) {
+            m_paths.emplace_back(*begin);
+        }
+
+        std::vector<std::uint64_t> hashes;
+        std::vector<std::uint32_t> order;
+
+        for (std::size_t i = 0; i < m_paths.size(); ++i) {
+            hashes.push_back(detail::hash_append(detail::hash_basis, m_paths[i].data(), m_paths[i].size()));
+            order.push_back(static_cast<std::uint32_t>(i));
+        }
+
+        // Paths with equal hashes can't be separated by any displacement.
+        std::sort(order.begin(), order.end(), [&hashes](std::uint32_t left, std::uint32_t right) {
+            return hashes[left] < hashes[right];
+        });
+
+        for (std::size_t i = 1; i < order.size(); ++i) {
+            if (hashes[order[i - 1]] == hashes[order[i]]) {
+                const std::string &first = m_paths[order[i - 1]];
+                const std::string &second = m_paths[order[i]];
+
+                if (first == second) {
+                    throw std::invalid_argument("Key path \"" + first + "\" is listed twice");
+                }
+
+                throw std::invalid_argument("Key paths \"" + first + "\" and \"" + second + "\" have the same hash");
+            }
+        }
+
+        for (std::size_t buckets = std::max<std::size_t>(1, m_paths.size() / bucket_load); !place(hashes, buckets); buckets *= 2) { }
+    }
+
+    // Finds displacements of the buckets, larger buckets first while there are many free slots.
+    bool place(const std::vector<std::uint64_t> &hashes, std::size_t bucket_count) {
+        std::vector<std::vector<std::uint32_t>> buckets(bucket_count);
+
+        for (std::size_t i = 0; i < hashes.size(); ++i) {
+            buckets[reduce(hashes[i], bucket_count)].push_back(static_cast<std::uint32_t>(i));
+        }
+
+        std::vector<std::uint32_t> order(bucket_count);
+
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            order[i] = static_cast<std::uint32_t>(i);
+        }
+
+        std::stable_sort(order.begin(), order.end(), [&buckets](std::uint32_t left, std::uint32_t right) {
+            return buckets[left].size() > buckets[right].size();
+        });
+
+        slot_t empty = { 0, npos };
+        m_slots.assign(hashes.size(), empty);
+        m_displacements.assign(bucket_count, 0);
+        std::vector<std::size_t> positions;
+
+        for (std::uint32_t bucket: order) {
+            const std::vector<std::uint32_t> &keys = buckets[bucket];
+
+            if (keys.empty()) {
+                break;
+            }
+
+            std::uint32_t displacement = 0;
+
+            while (!fits(hashes, keys, displacement, positions)) {
+                if (++displacement == max_displacement) {
+                    return false;
+                }
+            }
+
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                m_slots[positions[i]].hash = hashes[keys[i]];
+                m_slots[positions[i]].index = keys[i];
+            }
+
+            m_displacements[bucket] = displacement;
+        }
+
+        return true;
+    }
+
+    // Checks that the displacement moves all keys of a bucket to distinct free slots, which are put to positions.
+    bool fits(const std::vector<std::uint64_t> &hashes,
+              const std::vector<std::uint32_t> &keys,
+              std::uint32_t displacement,
+              std::vector<std::size_t> &positions) const
+    {
+        positions.clear();
+
+        for (std::uint32_t key: keys) {
+            std::size_t position = slot_position(hashes[key], displacement);
+
+            if (m_slots[position].index != npos || std::find(positions.begin(), positions.end(), position) != positions.end()) {
+                return false;
+            }
+
+            positions.push_back(position);
+        }
+
+        return true;
+    }
+
+private:
+    std::vector<std::string> m_paths;
+    std::vector<std::uint32_t> m_displacements;
+    std::vector<slot_t> m_slots;
+};
+
+
+namespace detail {
+
+
+constexpr bool equal_strings(const char *left, const char *right) {
+    return *left == *right && (*left == '\0' || equal_strings(left + 1, right + 1));
+}
+
+template<std::size_t N>
+constexpr std::uint32_t find_key_index(const char *const (&paths)[N], const char *path, std::size_t index) {
+    return index == N ? throw std::invalid_argument("The key path isn't listed")
+                      : equal_strings(paths[index], path) ? static_cast<std::uint32_t>(index)
+                                                          : find_key_index(paths, path, index + 1);
+}
+
+
+} // namespace detail
+
+
+/*! Index of a key path in a list of paths, computed at compile time for a constexpr list.
+ *
+ * With `constexpr const char *config_keys[] = {"title", "server.port"};` at namespace scope,
+ * a handler can dispatch keys of loltoml::key_schema_t(config_keys) with
+ * `case loltoml::key_index(config_keys, "server.port"):`. Paths missing from the list don't compile there.
+ *
+ * \throws std::invalid_argument if the path isn't listed (when evaluated at run time).
+ */
+template<std::size_t N>
+constexpr std::uint32_t key_index(const char *const (&paths)[N], const char *path) {
+    return detail::find_key_index(paths, path, 0);
+}
+
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_KEY_SCHEMA_HPP
@@ -1,8 +1,20 @@
 #ifndef LOLTOML_PARSE_HPP
 #define LOLTOML_PARSE_HPP
 
+#include "loltoml/action.hpp"
+#include "loltoml/datetime.hpp"
 #include "loltoml/detail/common.hpp"
+#include "loltoml/detail/key_checker.hpp"
 #include "loltoml/detail/parser.hpp"
+#include "loltoml/detail/schema_cursor.hpp"
+#include "loltoml/detail/stop_after_keys.hpp"
+#include "loltoml/detail/utf8.hpp"
+#include "loltoml/parse_options.hpp"
+#include "loltoml/string_ref.hpp"
+
+#include <iterator>
+#include <memory>
+#include <string>
 
 LOLTOML_OPEN_NAMESPACE
 
@@ -14,6 +26,38 @@ LOLTOML_OPEN_NAMESPACE
 typedef detail::key_iterator_t key_iterator_t;
 
 
+namespace detail {
+
+
+// Parses with the features of the options enabled, except validate_utf8 which needs the whole input beforehand.
+// Without any of them the parser is instantiated without optional features, so their checks are compiled out.
+template<class Input, class Handler>
+inline void parse_with_options(const Input &input, Handler &handler, const parse_options_t &options) {
+    const bool use_schema = options.key_schema && callbacks_t<Handler>::has_schema_key;
+
+    if (options.stop_after_keys.empty() && !options.check_duplicate_keys && !options.key_interner && !use_schema) {
+        parser_t<Handler, Input> parser(input, handler);
+        parser.parse();
+        return;
+    }
+
+    stop_after_keys_t stop_after_keys(options.stop_after_keys);
+    // Created only if asked for, so that other features don't pay for their allocations.
+    std::unique_ptr<key_checker_t> key_checker(options.check_duplicate_keys ? new key_checker_t : nullptr);
+    std::unique_ptr<schema_cursor_t> schema_cursor(use_schema ? new schema_cursor_t(*options.key_schema) : nullptr);
+    parser_t<Handler, Input, true> parser(input,
+                                          handler,
+                                          options.stop_after_keys.empty() ? nullptr : &stop_after_keys,
+                                          key_checker.get(),
+                                          options.key_interner,
+                                          schema_cursor.get());
+    parser.parse();
+}
+
+
+} // namespace detail
+
+
 /*! Parse a TOML document.
  *
  * This function reads a TOML document from the input stream and
@@ -21,10 +65,14 @@ typedef detail::key_iterator_t key_iterator_t;
  * This function only completes successfuly if the input stream contains a valid TOML document
  * as specified in https://github.com/toml-lang/toml/tree/v0.4.0
  * The only exceptions are:
- * - Though the spec states that a valid TOML document is utf-8 encoded, the parser doesn't validate encoding at the time.
- * - Since it's a SAX-style parser, it cannot track uniqueness of keys in tables.
+ * - Though the spec states that a valid TOML document is utf-8 encoded, the parser doesn't validate encoding
+ *   unless it's asked to by loltoml::parse_options_t.
+ * - Uniqueness of keys in tables isn't checked unless it's asked to by loltoml::parse_options_t::check_duplicate_keys.
+ * - Local date-times, local dates and local times of later versions of the spec are accepted along with offset date-times.
  *
- * The handler must have the following methods:
+ * The handler may have the following methods. All of them are optional: events without a method are skipped,
+ * and the parser doesn't even build their data (e.g. comments aren't copied if there is no comment() method).
+ * Beware that a method which cannot be called with the listed arguments is treated as missing.
  * - void start_document() - called at the start of parsing
  * - void finish_document() - called after parsing completes successfuly
  * - void comment(const std::string &comment) - called to handle a comment
@@ -42,10 +90,36 @@ typedef detail::key_iterator_t key_iterator_t;
  * - void finish_inline_table(std::size_t table_size) - handles end of an inline table. Size of the table is provided.
  * - void boolean(bool value) - handles boolean value.
  * - void string(const std::string &value) - handles a string (all kinds of strings: basic, multiline, literal, multiline literal).
- * - void datetime(const std::string &value) - handles datetime value.
- *     Though format of datetime values is validated, they're provided as strings, because I don't know what else to do with them.
+ * - void datetime(const loltoml::datetime_t &value) - handles a datetime value: an offset or local date-time,
+ *     a local date or a local time. Its fields are validated and converted, see loltoml::datetime_t.
+ * - void datetime(const loltoml::datetime_t &value, const std::string &text) - the same with the datetime as written.
+ *     It's called instead of the previous method if the handler has both.
+ * - void datetime(const std::string &text) - handles a datetime as written, if neither of the previous methods exists.
  * - void integer(std::int64_t value) - handles an integer value.
  * - void floating_point(double value) - handles a float value.
+ * - void symbol(const std::string &value) - handles a bare identifier used as a value (key = other_key).
+ *
+ * Skipping: key(), table() and array_table() may return loltoml::action_t instead of void.
+ * If key() returns action_t::skip, the value of the key (including nested arrays and inline tables) is skipped,
+ * if table() or array_table() returns it, the whole section up to the next table header is skipped.
+ * Skipped text produces no events, its strings aren't built, and it's only checked for the structure
+ * (strings, comments and brackets) needed to find its end.
+ *
+ * Stopping: any method except finish_document() may return loltoml::action_t::stop.
+ * Then the parser doesn't read anything else, calls finish_document() and returns normally.
+ * Arrays and inline tables open at that point are finished first with finish_array() and finish_inline_table(),
+ * whose sizes count the elements up to the one parsing stopped in.
+ *
+ * Zero-copy mode: if the handler declares `typedef loltoml::string_ref_t string_type;`
+ * (or any other type constructible from `(const char *, std::size_t)`, e.g. std::string_view),
+ * methods comment(), key(), string(), symbol() and the text of datetime() receive string_type instead of const std::string &.
+ * When parsing from a buffer, tokens without escape-sequences or line breaks then refer directly to the source,
+ * and only the rest are copied to an internal storage. In both cases the data is valid only until the method returns.
+ *
+ * Interned keys: with loltoml::parse_options_t::key_interner, a handler having
+ * `key(const loltoml::interned_key_t &key)` receives keys of key-value pairs interned instead of as strings.
+ * Likewise with loltoml::parse_options_t::key_schema, a handler having `key(const loltoml::schema_key_t &key)`
+ * receives indices of the key paths in the schema.
  *
  * \tparam Handler Type of the handler.
  * \param[in, out] input Stream containing a TOML document. It must be utf-8 encoded.
@@ -55,11 +129,84 @@ typedef detail::key_iterator_t key_iterator_t;
  */
 template<class Handler>
 inline void parse(std::istream &input, Handler &handler) {
-    detail::parser_t<Handler> parser(input, handler);
+    detail::parser_t<Handler> parser(detail::input_stream_t(input), handler);
     parser.parse();
 }
 
 
+/*! Parse a TOML document stored in a contiguous memory buffer.
+ *
+ * Works exactly like the stream version of loltoml::parse(), but reads characters directly from memory
+ * instead of going through std::istream. Offsets in the thrown errors are relative to begin.
+ *
+ * \tparam Handler Type of the handler.
+ * \param[in] begin Pointer to the first byte of the document. It must be utf-8 encoded.
+ * \param[in] end Pointer past the last byte of the document.
+ * \param[out] handler Parser will feed SAX-events to this object.
+ * \throws loltoml::parser_error_t if the buffer contains an invalid TOML document.
+ */
+template<class Handler>
+inline void parse(const char *begin, const char *end, Handler &handler) {
+    detail::parser_t<Handler, detail::input_buffer_t> parser(detail::input_buffer_t(begin, end), handler);
+    parser.parse();
+}
+
+
+/*! Parse a TOML document stored in a contiguous memory buffer with optional features enabled.
+ *
+ * \tparam Handler Type of the handler.
+ * \param[in] begin Pointer to the first byte of the document.
+ * \param[in] end Pointer past the last byte of the document.
+ * \param[out] handler Parser will feed SAX-events to this object.
+ * \param[in] options Features to enable, see loltoml::parse_options_t.
+ * \throws loltoml::parser_error_t if the buffer contains an invalid TOML document,
+ *     an ill-formed utf-8 sequence (if options.validate_utf8 is set)
+ *     or a key defined twice (if options.check_duplicate_keys is set).
+ */
+template<class Handler>
+inline void parse(const char *begin, const char *end, Handler &handler, const parse_options_t &options) {
+    if (options.validate_utf8) {
+        const char *error = detail::utf8::validate(begin, end);
+
+        if (error != end) {
+            throw parser_error_t("Invalid utf-8 sequence", static_cast<std::size_t>(error - begin));
+        }
+    }
+
+    detail::parse_with_options(detail::input_buffer_t(begin, end), handler, options);
+}
+
+
+/*! Parse a TOML document from a stream with optional features enabled.
+ *
+ * With options.stop_after_keys the stream isn't read past the expression delivering the last of the keys.
+ * Validation of utf-8 needs the whole document, so with options.validate_utf8 the stream is read into memory first.
+ *
+ * \tparam Handler Type of the handler.
+ * \param[in, out] input Stream containing a TOML document.
+ * \param[out] handler Parser will feed SAX-events to this object.
+ * \param[in] options Features to enable, see loltoml::parse_options_t.
+ * \throws loltoml::parser_error_t if the input contains an invalid TOML document,
+ *     an ill-formed utf-8 sequence (if options.validate_utf8 is set)
+ *     or a key defined twice (if options.check_duplicate_keys is set).
+ * \throws loltoml::stream_error_t if input.bad() becomes true.
+ */
+template<class Handler>
+inline void parse(std::istream &input, Handler &handler, const parse_options_t &options) {
+    if (options.validate_utf8) {
+        std::string document((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+        if (input.bad()) {
+            throw stream_error_t(document.size());
+        }
+
+        parse(document.data(), document.data() + document.size(), handler, options);
+    } else {
+        detail::parse_with_options(detail::input_stream_t(input), handler, options);
+    }
+}
+
+
 LOLTOML_CLOSE_NAMESPACE
 
 #endif // LOLTOML_PARSE_HPP
@@ -0,0 +1,50 @@
+#ifndef LOLTOML_PARSE_FILE_HPP
+#define LOLTOML_PARSE_FILE_HPP
+
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/mapped_file.hpp"
+#include "loltoml/parse.hpp"
+
+LOLTOML_OPEN_NAMESPACE
+
+
+/*! Parse a TOML document from a file.
+ *
+ * The file is mapped into memory read-only and parsed in place, so its contents are never copied.
+ * Files which aren't regular files (pipes, devices, /proc files) are read into memory up to their end instead.
+ * Requires a POSIX system.
+ * See the stream version of loltoml::parse() for requirements to the handler.
+ *
+ * \tparam Handler Type of the handler.
+ * \param[in] path Path to the file. It must be utf-8 encoded.
+ * \param[out] handler Parser will feed SAX-events to this object.
+ * \throws loltoml::parser_error_t if the file contains an invalid TOML document.
+ *     Offsets are relative to the start of the file.
+ * \throws loltoml::file_error_t if the file cannot be opened, mapped or read (e.g. it's a directory).
+ */
+template<class Handler>
+inline void parse_file(const char *path, Handler &handler) {
+    detail::mapped_file_t file(path);
+    parse(file.begin(), file.end(), handler);
+}
+
+
+/*! Parse a TOML document from a file with optional features enabled.
+ *
+ * \tparam Handler Type of the handler.
+ * \param[in] path Path to the file.
+ * \param[out] handler Parser will feed SAX-events to this object.
+ * \param[in] options Features to enable, see loltoml::parse_options_t.
+ * \throws loltoml::parser_error_t if the file contains an invalid TOML document.
+ * \throws loltoml::file_error_t if the file cannot be opened, mapped or read (e.g. it's a directory).
+ */
+template<class Handler>
+inline void parse_file(const char *path, Handler &handler, const parse_options_t &options) {
+    detail::mapped_file_t file(path);
+    parse(file.begin(), file.end(), handler, options);
+}
+
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_PARSE_FILE_HPP
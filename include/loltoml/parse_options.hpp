@@ -0,0 +1,77 @@
+#ifndef LOLTOML_PARSE_OPTIONS_HPP
+#define LOLTOML_PARSE_OPTIONS_HPP
+
+#include "loltoml/detail/common.hpp"
+#include "loltoml/key_interner.hpp"
+#include "loltoml/key_schema.hpp"
+
+#include <string>
+#include <vector>
+
+LOLTOML_OPEN_NAMESPACE
+
+
+/*! Optional features of the parser.
+ *
+ * All of them are disabled by default, so that the parser does only the work required to produce SAX-events.
+ */
+struct parse_options_t {
+    parse_options_t() :
+        validate_utf8(false),
+        check_duplicate_keys(false),
+        key_interner(nullptr),
+        key_schema(nullptr)
+    { }
+
+    /*! Check that the whole document is valid utf-8 before feeding any events to the handler.
+     *
+     * Overlong encodings, surrogates, code points above U+10FFFF and truncated sequences are rejected
+     * with loltoml::parser_error_t pointing to the first byte of the ill-formed sequence.
+     * Streams are read into memory to be validated before parsing.
+     */
+    bool validate_utf8;
+
+    /*! Stop parsing as soon as values of all these keys are delivered to the handler, without reading the rest of the input.
+     *
+     * Each path is the table path followed by the key, e.g. {"server", "port"} for `port` in `[server]`,
+     * and {"title"} for a key before the first table header. Keys of inline tables are addressed
+     * through the enclosing keys: {"owner", "name"} for `owner = { name = "x" }`.
+     * Keys of array tables, and of inline tables inside arrays, are delivered with their first occurrence.
+     * When parsing stops, enclosing arrays and inline tables are finished and finish_document() is called as usual.
+     */
+    std::vector<std::vector<std::string>> stop_after_keys;
+
+    /*! Reject documents defining a key or a table twice, as required by the spec.
+     *
+     * This covers keys of a table (including tables created implicitly by headers like [a.b]),
+     * tables defined by two headers, headers through keys holding values, and [[a]] for a key which isn't an array of tables.
+     * Errors point to the key or to the '[' of the header. Keys are checked in constant time each,
+     * but the checker keeps a node for every key of the document.
+     * Keys inside sections and values skipped by the handler aren't checked.
+     */
+    bool check_duplicate_keys;
+
+    /*! Intern keys of key-value pairs into this interner and pass them to `key(const loltoml::interned_key_t &)` of the handler.
+     *
+     * The interner is owned by the caller and may be shared by many parses (one at a time),
+     * so that documents with the same keys are parsed without allocating anything for the keys
+     * and the handler can compare them by id. Handlers without such a method receive keys as usual.
+     * Keys of table headers are still passed as strings.
+     */
+    key_interner_t *key_interner;
+
+    /*! Look paths of keys of key-value pairs up in this schema and pass them to `key(const loltoml::schema_key_t &)` of the handler.
+     *
+     * Keys the schema doesn't list get loltoml::key_schema_t::npos, so handlers of a known schema become switch statements
+     * over indices, and may return loltoml::action_t::skip for unknown keys. The path of a key is hashed once,
+     * incrementally from the hash of its table. The schema is owned by the caller and isn't modified by parsing.
+     * Handlers without such a method receive keys as usual (the schema takes precedence over key_interner).
+     * Keys of table headers are still passed as strings.
+     */
+    const key_schema_t *key_schema;
+};
+
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_PARSE_OPTIONS_HPP
@@ -0,0 +1,389 @@
+#ifndef LOLTOML_READER_HPP
+#define LOLTOML_READER_HPP
+
+#include "loltoml/detail/callbacks.hpp"
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/input_buffer.hpp"
+#include "loltoml/detail/key_checker.hpp"
+#include "loltoml/detail/parser.hpp"
+#include "loltoml/detail/stop_after_keys.hpp"
+#include "loltoml/detail/utf8.hpp"
+#include "loltoml/error.hpp"
+#include "loltoml/parse_options.hpp"
+#include "loltoml/string_ref.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+LOLTOML_OPEN_NAMESPACE
+
+
+//! Types of events produced by loltoml::reader_t. They match methods of SAX-handlers (see loltoml::parse()).
+enum class event_type_t {
+    comment,
+    table,
+    array_table,
+    key,
+    start_array,
+    finish_array,
+    start_inline_table,
+    finish_inline_table,
+    boolean,
+    string,
+    datetime,
+    integer,
+    floating_point,
+    symbol
+};
+
+
+/*! Event produced by loltoml::reader_t.
+ *
+ * Which fields are set depends on the type:
+ * - text for comment, key, string, datetime and symbol;
+ * - path_begin and path_end (the sequence of keys) for table and array_table;
+ * - size for finish_array and finish_inline_table;
+ * - boolean, integer and floating_point for values of these types.
+ *
+ * Strings and keys are valid only until the next call of loltoml::reader_t::next().
+ */
+struct event_t {
+    event_type_t type;
+    string_ref_t text;
+    const string_ref_t *path_begin;
+    const string_ref_t *path_end;
+
+    union {
+        bool boolean;
+        std::int64_t integer;
+        double floating_point;
+        std::size_t size;
+    };
+};
+
+
+namespace detail {
+
+
+/*
+ * Handler collecting events of an expression for reader_t.
+ * Strings referring to the document are kept as is, the rest are copied to the storage,
+ * which is reused for all expressions.
+ */
+class event_queue_t {
+public:
+    typedef string_ref_t string_type;
+
+    event_queue_t(const char *begin, const char *end) :
+        m_begin(begin),
+        m_end(end)
+    { }
+
+    void comment(string_ref_t value) {
+        push_text(event_type_t::comment, value);
+    }
+
+    void array_table(key_iterator_t begin, key_iterator_t end) {
+        push_path(event_type_t::array_table, begin, end);
+    }
+
+    void table(key_iterator_t begin, key_iterator_t end) {
+        push_path(event_type_t::table, begin, end);
+    }
+
+    void key(string_ref_t value) {
+        push_text(event_type_t::key, value);
+    }
+
+    void start_array() {
+        push(event_type_t::start_array);
+    }
+
+    void finish_array(std::size_t size) {
+        push(event_type_t::finish_array).size = size;
+    }
+
+    void start_inline_table() {
+        push(event_type_t::start_inline_table);
+    }
+
+    void finish_inline_table(std::size_t size) {
+        push(event_type_t::finish_inline_table).size = size;
+    }
+
+    void boolean(bool value) {
+        push(event_type_t::boolean).boolean = value;
+    }
+
+    void string(string_ref_t value) {
+        push_text(event_type_t::string, value);
+    }
+
+    void datetime(string_ref_t value) {
+        push_text(event_type_t::datetime, value);
+    }
+
+    void integer(std::int64_t value) {
+        push(event_type_t::integer).integer = value;
+    }
+
+    void floating_point(double value) {
+        push(event_type_t::floating_point).floating_point = value;
+    }
+
+    void symbol(string_ref_t value) {
+        push_text(event_type_t::symbol, value);
+    }
+
+    // Drops all events and copied strings.
+    void clear() {
+        m_events.clear();
+        m_stored.clear();
+        m_storage.clear();
+        m_path.clear();
+        m_paths.clear();
+    }
+
+    // Points copied strings to the storage. It must be called after an expression is parsed,
+    // because the storage may be reallocated while the events are collected.
+    void resolve() {
+        for (std::size_t i = 0; i < m_stored.size(); ++i) {
+            string_ref_t &text = m_events[m_stored[i].event_index].text;
+            text = string_ref_t(m_storage.data() + m_stored[i].offset, text.size());
+        }
+
+        for (std::size_t i = 0; i < m_paths.size(); ++i) {
+            const path_range_t &range = m_paths[i];
+            std::size_t offset = range.offset;
+
+            for (std::size_t key = range.begin; key < range.end; ++key) {
+                m_path[key] = string_ref_t(m_storage.data() + offset, m_path[key].size());
+                offset += m_path[key].size();
+            }
+
+            m_events[range.event_index].path_begin = m_path.data() + range.begin;
+            m_events[range.event_index].path_end = m_path.data() + range.end;
+        }
+    }
+
+    std::size_t size() const {
+        return m_events.size();
+    }
+
+    const event_t &operator[](std::size_t index) const {
+        return m_events[index];
+    }
+
+private:
+    struct stored_string_t {
+        std::size_t event_index;
+        std::size_t offset;
+    };
+
+    // Keys of a table header are m_path[begin, end), they are stored one after another from the offset.
+    struct path_range_t {
+        std::size_t event_index;
+        std::size_t begin;
+        std::size_t end;
+        std::size_t offset;
+    };
+
+    event_t &push(event_type_t type) {
+        m_events.push_back(event_t());
+        m_events.back().type = type;
+        return m_events.back();
+    }
+
+    bool in_document(string_ref_t value) const {
+        std::less_equal<const char *> less_equal;
+        return less_equal(m_begin, value.data()) && less_equal(value.data() + value.size(), m_end);
+    }
+
+    // Strings pointing to the document are kept as is, the rest are copied and set by resolve().
+    void push_text(event_type_t type, string_ref_t value) {
+        event_t &event = push(type);
+
+        if (!value.empty() && !in_document(value)) {
+            stored_string_t stored = { m_events.size() - 1, m_storage.size() };
+            m_stored.push_back(stored);
+            m_storage.append(value.data(), value.size());
+        }
+
+        event.text = value;
+    }
+
+    // Keys of table headers are always copied, because the parser passes them as std::string.
+    void push_path(event_type_t type, key_iterator_t begin, key_iterator_t end) {
+        path_range_t range = { m_events.size(), m_path.size(), m_path.size(), m_storage.size() };
+        push(type);
+
+        for (; begin != end; ++begin) {
+            m_storage.append(*begin);
+            m_path.push_back(string_ref_t(nullptr, begin->size()));
+        }
+
+        // m_path may be reallocated, so only indices are saved until resolve().
+        range.end = m_path.size();
+        m_paths.push_back(range);
+    }
+
+private:
+    const char *m_begin;
+    const char *m_end;
+    std::vector<event_t> m_events;
+    std::vector<stored_string_t> m_stored;
+    std::string m_storage;
+    std::vector<string_ref_t> m_path;
+    std::vector<path_range_t> m_paths;
+};
+
+
+} // namespace detail
+
+
+/*! Pull-style parser: reads a TOML document from a buffer event by event.
+ *
+ * Produces the same events as loltoml::parse() except start_document and finish_document,
+ * but the caller asks for them instead of being called back, so it may stop at any point,
+ * skip values it isn't interested in or do other work between events.
+ *
+ * The document is parsed lazily, one top-level expression (key-value pair, table header) at a time.
+ * Events of the expression are queued, and strings which refer to the buffer aren't copied.
+ *
+ * Usage:
+ * \code
+ * loltoml::reader_t reader(begin, end);
+ *
+ * while (reader.next()) {
+ *     const loltoml::event_t &event = reader.event();
+ *     ...
+ * }
+ * \endcode
+ */
+class reader_t {
+public:
+    /*!
+     * \param[in] begin Pointer to the first byte of the document. It must be utf-8 encoded.
+     *     The buffer must outlive the reader.
+     * \param[in] end Pointer past the last byte of the document.
+     * \param[in] options Features to enable, see loltoml::parse_options_t.
+     *     With options.stop_after_keys the document is over once the events of the last of the keys are read,
+     *     with options.check_duplicate_keys next() throws on the second definition.
+     *     Events carry keys as strings, so options.key_interner and options.key_schema don't apply.
+     * \throws loltoml::parser_error_t if options.validate_utf8 is set and the buffer contains an ill-formed utf-8 sequence.
+     */
+    reader_t(const char *begin, const char *end, const parse_options_t &options = parse_options_t()) :
+        m_queue(begin, end),
+        m_stop_after_keys(options.stop_after_keys),
+        m_key_checker(options.check_duplicate_keys ? new detail::key_checker_t : nullptr),
+        m_parser(detail::input_buffer_t(begin, end),
+                 m_queue,
+                 options.stop_after_keys.empty() ? nullptr : &m_stop_after_keys,
+                 m_key_checker.get()),
+        m_position(0),
+        m_finished(false),
+        m_event(nullptr)
+    {
+        if (options.validate_utf8) {
+            const char *error = detail::utf8::validate(begin, end);
+
+            if (error != end) {
+                throw parser_error_t("Invalid utf-8 sequence", static_cast<std::size_t>(error - begin));
+            }
+        }
+    }
+
+    reader_t(const reader_t &) = delete;
+    reader_t &operator=(const reader_t &) = delete;
+
+    /*! Read the next event.
+     *
+     * \return false if the document is over.
+     * \throws loltoml::parser_error_t if the document is invalid. The reader must not be used after that.
+     */
+    bool next() {
+        while (m_position == m_queue.size()) {
+            if (m_finished) {
+                return false;
+            }
+
+            m_queue.clear();
+            m_position = 0;
+
+            try {
+                if (!m_parser.parse_next_expression()) {
+                    m_finished = true;
+                    return false;
+                }
+            } catch (const detail::stop_parsing_t &) {
+                // Events of the last requested key are still read, followed by the ends of its containers.
+                m_parser.close_containers();
+                m_finished = true;
+            }
+
+            m_queue.resolve();
+        }
+
+        m_event = &m_queue[m_position++];
+        return true;
+    }
+
+    //! The last event read by next(). It's valid only if next() returned true.
+    const event_t &event() const {
+        return *m_event;
+    }
+
+    /*! Skip the value started by the last event.
+     *
+     * After start_array or start_inline_table it skips everything up to the matching finish event,
+     * after key it skips the value of the key. Otherwise does nothing.
+     * event() is undefined after the call.
+     *
+     * \throws loltoml::parser_error_t if the document is invalid.
+     */
+    void skip() {
+        if (event().type == event_type_t::key && !next()) {
+            return;
+        }
+
+        if (event().type != event_type_t::start_array && event().type != event_type_t::start_inline_table) {
+            return;
+        }
+
+        std::size_t depth = 1;
+
+        while (depth > 0 && next()) {
+            switch (event().type) {
+                case event_type_t::start_array:
+                case event_type_t::start_inline_table:
+                    ++depth;
+                    break;
+                case event_type_t::finish_array:
+                case event_type_t::finish_inline_table:
+                    --depth;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+private:
+    detail::event_queue_t m_queue;
+    detail::stop_after_keys_t m_stop_after_keys;
+    std::unique_ptr<detail::key_checker_t> m_key_checker;
+    detail::parser_t<detail::event_queue_t, detail::input_buffer_t, true> m_parser;
+    // Index of the next event in the queue.
+    std::size_t m_position;
+    bool m_finished;
+    const event_t *m_event;
+};
+
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_READER_HPP
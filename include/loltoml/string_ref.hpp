@@ -0,0 +1,111 @@
+#ifndef LOLTOML_STRING_REF_HPP
+#define LOLTOML_STRING_REF_HPP
+
+#include "loltoml/detail/common.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+LOLTOML_OPEN_NAMESPACE
+
+
+/*! Non-owning reference to a sequence of characters, a minimal C++11 replacement for std::string_view.
+ *
+ * Handlers declaring `typedef loltoml::string_ref_t string_type;` receive strings of this type (see loltoml::parse()).
+ */
+class string_ref_t {
+public:
+    typedef const char *const_iterator;
+    typedef const_iterator iterator;
+
+    string_ref_t() :
+        m_data(nullptr),
+        m_size(0)
+    { }
+
+    string_ref_t(const char *data, std::size_t size) :
+        m_data(data),
+        m_size(size)
+    { }
+
+    string_ref_t(const char *str) :
+        m_data(str),
+        m_size(std::strlen(str))
+    { }
+
+    string_ref_t(const std::string &str) :
+        m_data(str.data()),
+        m_size(str.size())
+    { }
+
+    const char *data() const {
+        return m_data;
+    }
+
+    std::size_t size() const {
+        return m_size;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    const_iterator begin() const {
+        return m_data;
+    }
+
+    const_iterator end() const {
+        return m_data + m_size;
+    }
+
+    char operator[](std::size_t index) const {
+        return m_data[index];
+    }
+
+    //! \returns Copy of the referenced characters.
+    std::string str() const {
+        return std::string(m_data, m_size);
+    }
+
+    explicit operator std::string() const {
+        return str();
+    }
+
+#if __cplusplus >= 201703L
+    operator std::string_view() const {
+        return std::string_view(m_data, m_size);
+    }
+#endif
+
+private:
+    const char *m_data;
+    std::size_t m_size;
+};
+
+inline bool operator==(string_ref_t left, string_ref_t right) {
+    return left.size() == right.size() && (left.size() == 0 || std::memcmp(left.data(), right.data(), left.size()) == 0);
+}
+
+inline bool operator!=(string_ref_t left, string_ref_t right) {
+    return !(left == right);
+}
+
+inline bool operator<(string_ref_t left, string_ref_t right) {
+    return std::lexicographical_compare(left.begin(), left.end(), right.begin(), right.end());
+}
+
+inline std::ostream &operator<<(std::ostream &output, string_ref_t value) {
+    return output.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_STRING_REF_HPP
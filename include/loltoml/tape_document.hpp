@@ -0,0 +1,575 @@
+#ifndef LOLTOML_TAPE_DOCUMENT_HPP
+#define LOLTOML_TAPE_DOCUMENT_HPP
+
+#include "loltoml/detail/common.hpp"
+#include "loltoml/error.hpp"
+#include "loltoml/parse.hpp"
+#include "loltoml/parse_options.hpp"
+#include "loltoml/string_ref.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+LOLTOML_OPEN_NAMESPACE
+
+
+/*! Types of entries of loltoml::tape_document_t. Values are the tags stored in the top byte of tape words. */
+enum class tape_type_t : std::uint8_t {
+    root = 'r',
+    table = 't',
+    array_table = 'T',
+    key = 'k',
+    start_array = '[',
+    finish_array = ']',
+    start_inline_table = '{',
+    finish_inline_table = '}',
+    boolean = 'b',
+    string = 's',
+    datetime = 'd',
+    integer = 'i',
+    floating_point = 'f',
+    symbol = 'y'
+};
+
+
+namespace detail {
+
+
+    const unsigned tape_type_shift = 56;
+
+    inline std::uint64_t tape_word(tape_type_t type, std::uint64_t payload) {
+        return (static_cast<std::uint64_t>(type) << tape_type_shift) | payload;
+    }
+
+    inline tape_type_t tape_type(std::uint64_t word) {
+        return static_cast<tape_type_t>(word >> tape_type_shift);
+    }
+
+    inline std::uint64_t tape_payload(std::uint64_t word) {
+        return word & ((std::uint64_t(1) << tape_type_shift) - 1);
+    }
+
+    // See tape_document_t::next().
+    inline std::size_t tape_next(const std::vector<std::uint64_t> &tape, std::size_t index) {
+        std::size_t payload = static_cast<std::size_t>(tape_payload(tape[index]));
+
+        switch (tape_type(tape[index])) {
+            case tape_type_t::root:
+                return payload == 0 ? index + 1 : payload + 1;
+            case tape_type_t::table:
+            case tape_type_t::array_table:
+                return payload;
+            case tape_type_t::start_array:
+            case tape_type_t::start_inline_table:
+                return payload + 1;
+            case tape_type_t::integer:
+            case tape_type_t::floating_point:
+                return index + 2;
+            default:
+                return index + 1;
+        }
+    }
+
+    // Checks that a string entry lies inside the string buffer: its size, the characters and the '\0'.
+    inline bool tape_string_valid(const std::string &strings, std::uint64_t offset) {
+        if (offset > strings.size() || strings.size() - offset < sizeof(std::uint32_t) + 1) {
+            return false;
+        }
+
+        std::uint32_t size;
+        std::memcpy(&size, strings.data() + offset, sizeof(size));
+        std::size_t available = strings.size() - static_cast<std::size_t>(offset) - sizeof(size) - 1;
+
+        return size <= available && strings[static_cast<std::size_t>(offset) + sizeof(size) + size] == '\0';
+    }
+
+    /*
+     * Checks that every index and offset stored in a tape points where the accessors of tape_document_t expect,
+     * so that traversing a loaded document stays in bounds. Returns the description of the first problem or nullptr.
+     */
+    inline const char *tape_error(const std::vector<std::uint64_t> &tape, const std::string &strings) {
+        if (tape.size() < 2 || tape_type(tape[0]) != tape_type_t::root || tape_payload(tape[0]) != tape.size() - 1 ||
+            tape.back() != tape_word(tape_type_t::root, 0))
+        {
+            return "The tape doesn't start and end with root words";
+        }
+
+        std::size_t last = tape.size() - 1;
+        // Starts of open arrays and inline tables, and the current header (0 before the first one).
+        std::vector<std::size_t> open;
+        std::size_t section = 0;
+
+        for (std::size_t index = 1; index < last;) {
+            std::uint64_t payload = tape_payload(tape[index]);
+
+            switch (tape_type(tape[index])) {
+                case tape_type_t::table:
+                case tape_type_t::array_table: {
+                    if (!open.empty()) {
+                        return "A header is inside an array or an inline table";
+                    }
+
+                    if (section != 0 && tape_payload(tape[section]) != index) {
+                        return "A header doesn't point to the next one";
+                    }
+
+                    if (last - index < 2 || tape[index + 1] == 0 || tape[index + 1] > last - index - 2) {
+                        return "A header has an invalid number of keys";
+                    }
+
+                    std::size_t keys_end = index + 2 + static_cast<std::size_t>(tape[index + 1]);
+
+                    for (std::size_t key = index + 2; key < keys_end; ++key) {
+                        if (tape_type(tape[key]) != tape_type_t::key || !tape_string_valid(strings, tape_payload(tape[key]))) {
+                            return "A header has an invalid key";
+                        }
+                    }
+
+                    section = index;
+                    index = keys_end;
+                    continue;
+                }
+                case tape_type_t::key:
+                case tape_type_t::string:
+                case tape_type_t::datetime:
+                case tape_type_t::symbol:
+                    if (!tape_string_valid(strings, payload)) {
+                        return "A string lies outside of the string buffer";
+                    }
+                    break;
+                case tape_type_t::start_array:
+                case tape_type_t::start_inline_table:
+                    if (payload <= index || payload >= last) {
+                        return "An array or an inline table ends outside of the tape";
+                    }
+                    open.push_back(index);
+                    break;
+                case tape_type_t::finish_array:
+                case tape_type_t::finish_inline_table: {
+                    tape_type_t start = tape_type(tape[index]) == tape_type_t::finish_array ? tape_type_t::start_array
+                                                                                           : tape_type_t::start_inline_table;
+
+                    if (open.empty() || tape_type(tape[open.back()]) != start || tape_payload(tape[open.back()]) != index) {
+                        return "An array or an inline table doesn't match its end";
+                    }
+
+                    open.pop_back();
+                    break;
+                }
+                case tape_type_t::boolean:
+                    if (payload > 1) {
+                        return "A boolean is neither 0 nor 1";
+                    }
+                    break;
+                case tape_type_t::integer:
+                case tape_type_t::floating_point:
+                    if (last - index < 2) {
+                        return "A number has no value word";
+                    }
+                    ++index;
+                    break;
+                default:
+                    return "The tape contains an unknown entry";
+            }
+
+            ++index;
+        }
+
+        if (!open.empty()) {
+            return "An array or an inline table isn't finished";
+        }
+
+        if (section != 0 && tape_payload(tape[section]) != last) {
+            return "The last header doesn't point to the end of the tape";
+        }
+
+        return nullptr;
+    }
+
+    // Reads size bytes into the container, which grows as the data arrives, so that a corrupted size
+    // ends with a stream error instead of a huge allocation. Returns the number of bytes read.
+    template<class Container>
+    std::size_t tape_read(std::istream &input, Container &container, std::uint64_t size) {
+        const std::size_t chunk = 1 << 20;
+        typedef typename Container::value_type value_type;
+        std::size_t bytes = 0;
+
+        while (bytes < size) {
+            std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(chunk, size - bytes));
+            container.resize((bytes + count) / sizeof(value_type));
+
+            if (!input.read(reinterpret_cast<char *>(&container[0]) + bytes, static_cast<std::streamsize>(count))) {
+                return bytes + static_cast<std::size_t>(input.gcount());
+            }
+
+            bytes += count;
+        }
+
+        return bytes;
+    }
+
+
+} // namespace detail
+
+
+/*! Flat representation of a parsed TOML document, in the spirit of the simdjson tape.
+ *
+ * The document is stored as two buffers: the tape of 64-bit words and the strings.
+ * Each entry of the tape starts with a word with the tape_type_t in the top 8 bits and a payload in the other 56 bits.
+ * Entries follow the SAX-events (see loltoml::parse()) in order of the document:
+ * - root: the first and the last word. The payload of the first is the index of the last.
+ * - table, array_table: a header. The payload is the index of the next header or of the last root word,
+ *     so a whole section can be skipped at once. The next word is the number of keys in the header,
+ *     they follow as key entries.
+ * - key, string, datetime, symbol: the payload is the offset of the string in the string buffer.
+ *     A string is stored there as its 32-bit size, the characters and a '\0'.
+ * - start_array, start_inline_table: the payload is the index of the matching finish word.
+ * - finish_array, finish_inline_table: the payload is the number of elements.
+ * - boolean: the payload is 0 or 1.
+ * - integer, floating_point: the value is stored in the next word.
+ *
+ * The buffers contain no pointers, so a document can be saved and loaded by copying them (see write() and read()).
+ * Duplicate keys aren't detected, just as with loltoml::parse().
+ */
+class tape_document_t {
+public:
+
+    //! An empty document.
+    tape_document_t() :
+        m_tape({detail::tape_word(tape_type_t::root, 1), detail::tape_word(tape_type_t::root, 0)})
+    { }
+
+    //! Document made of the buffers of another one, e.g. from tape() and strings().
+    tape_document_t(std::vector<std::uint64_t> tape, std::string strings) :
+        m_tape(std::move(tape)),
+        m_strings(std::move(strings))
+    { }
+
+    const std::vector<std::uint64_t> &tape() const {
+        return m_tape;
+    }
+
+    const std::string &strings() const {
+        return m_strings;
+    }
+
+    tape_type_t type(std::size_t index) const {
+        return detail::tape_type(m_tape[index]);
+    }
+
+    std::uint64_t payload(std::size_t index) const {
+        return detail::tape_payload(m_tape[index]);
+    }
+
+    //! String of a key, string, datetime or symbol entry.
+    string_ref_t string_at(std::size_t index) const {
+        assert(type(index) == tape_type_t::key || type(index) == tape_type_t::string ||
+               type(index) == tape_type_t::datetime || type(index) == tape_type_t::symbol);
+
+        const char *entry = m_strings.data() + payload(index);
+        std::uint32_t size;
+        std::memcpy(&size, entry, sizeof(size));
+
+        return string_ref_t(entry + sizeof(size), size);
+    }
+
+    bool boolean_at(std::size_t index) const {
+        assert(type(index) == tape_type_t::boolean);
+        return payload(index) != 0;
+    }
+
+    std::int64_t integer_at(std::size_t index) const {
+        assert(type(index) == tape_type_t::integer);
+        return static_cast<std::int64_t>(m_tape[index + 1]);
+    }
+
+    double floating_point_at(std::size_t index) const {
+        assert(type(index) == tape_type_t::floating_point);
+        double result;
+        std::memcpy(&result, &m_tape[index + 1], sizeof(result));
+        return result;
+    }
+
+    //! Number of keys of a table or array_table header. Keys are the key entries from index + 2.
+    std::size_t path_size(std::size_t index) const {
+        assert(type(index) == tape_type_t::table || type(index) == tape_type_t::array_table);
+        return static_cast<std::size_t>(m_tape[index + 1]);
+    }
+
+    /*! Index of the entry following the entry at index, skipping everything inside it.
+     *
+     * Arrays and inline tables are skipped with their elements, headers with their whole sections,
+     * the first root word with the whole document. It takes O(1).
+     */
+    std::size_t next(std::size_t index) const {
+        return detail::tape_next(m_tape, index);
+    }
+
+    /*! Save the document.
+     *
+     * The format is the sizes of the buffers followed by their contents, in the native byte order.
+     */
+    void write(std::ostream &output) const {
+        std::uint64_t sizes[] = { m_tape.size(), m_strings.size() };
+        output.write(reinterpret_cast<const char *>(sizes), sizeof(sizes));
+        output.write(reinterpret_cast<const char *>(m_tape.data()), static_cast<std::streamsize>(m_tape.size() * sizeof(std::uint64_t)));
+        output.write(m_strings.data(), static_cast<std::streamsize>(m_strings.size()));
+    }
+
+    /*! Load a document saved by write().
+     *
+     * The document is checked to be a well-formed tape before it's returned: entries of known types,
+     * matching starts and ends of arrays and inline tables, headers pointing to the next ones and strings inside the string buffer,
+     * so that traversing it stays in bounds. Values aren't checked against each other, e.g. a key may be followed by another key.
+     * Snapshots are portable only between builds of the same byte order.
+     *
+     * \throws loltoml::stream_error_t if the input cannot be read.
+     * \throws loltoml::document_error_t if the input isn't a well-formed tape.
+     */
+    static tape_document_t read(std::istream &input) {
+        std::uint64_t sizes[2];
+
+        if (!input.read(reinterpret_cast<char *>(sizes), sizeof(sizes))) {
+            throw stream_error_t(static_cast<std::size_t>(input.gcount()));
+        }
+
+        if (sizes[0] > (std::numeric_limits<std::size_t>::max() / sizeof(std::uint64_t)) || sizes[1] > std::numeric_limits<std::size_t>::max()) {
+            throw document_error_t("The sizes of the buffers are too large");
+        }
+
+        std::vector<std::uint64_t> tape;
+        std::string strings;
+        std::size_t tape_bytes = static_cast<std::size_t>(sizes[0]) * sizeof(std::uint64_t);
+        std::size_t read_bytes = detail::tape_read(input, tape, tape_bytes);
+
+        if (read_bytes != tape_bytes) {
+            throw stream_error_t(sizeof(sizes) + read_bytes);
+        }
+
+        read_bytes = detail::tape_read(input, strings, sizes[1]);
+
+        if (read_bytes != sizes[1]) {
+            throw stream_error_t(sizeof(sizes) + tape_bytes + read_bytes);
+        }
+
+        if (const char *error = detail::tape_error(tape, strings)) {
+            throw document_error_t(error);
+        }
+
+        return tape_document_t(std::move(tape), std::move(strings));
+    }
+
+private:
+    std::vector<std::uint64_t> m_tape;
+    std::string m_strings;
+};
+
+
+namespace detail {
+
+
+/*
+ * Handler writing the tape. Starts of open arrays and inline tables are kept on a stack
+ * to be patched with indices of their ends, headers are patched when the next one starts.
+ */
+class tape_builder_t {
+public:
+    typedef string_ref_t string_type;
+
+    tape_builder_t(std::vector<std::uint64_t> &tape, std::string &strings) :
+        m_tape(tape),
+        m_strings(strings),
+        m_section(0)
+    { }
+
+    void start_document() {
+        m_tape.clear();
+        m_strings.clear();
+        m_open.clear();
+        m_section = 0;
+        push(tape_type_t::root, 0);
+    }
+
+    void finish_document() {
+        // Arrays and inline tables are left open if the handler or the options stopped the parser inside them.
+        while (!m_open.empty()) {
+            std::size_t start = m_open.back();
+            bool is_array = tape_type(m_tape[start]) == tape_type_t::start_array;
+            close(is_array ? tape_type_t::finish_array : tape_type_t::finish_inline_table, count_elements(start));
+        }
+
+        finish_section();
+        m_tape[0] |= m_tape.size();
+        push(tape_type_t::root, 0);
+    }
+
+    void table(key_iterator_t begin, key_iterator_t end) {
+        header(tape_type_t::table, begin, end);
+    }
+
+    void array_table(key_iterator_t begin, key_iterator_t end) {
+        header(tape_type_t::array_table, begin, end);
+    }
+
+    void key(string_ref_t value) {
+        push_string(tape_type_t::key, value);
+    }
+
+    void start_array() {
+        m_open.push_back(m_tape.size());
+        push(tape_type_t::start_array, 0);
+    }
+
+    void finish_array(std::size_t size) {
+        close(tape_type_t::finish_array, size);
+    }
+
+    void start_inline_table() {
+        m_open.push_back(m_tape.size());
+        push(tape_type_t::start_inline_table, 0);
+    }
+
+    void finish_inline_table(std::size_t size) {
+        close(tape_type_t::finish_inline_table, size);
+    }
+
+    void boolean(bool value) {
+        push(tape_type_t::boolean, value ? 1 : 0);
+    }
+
+    void string(string_ref_t value) {
+        push_string(tape_type_t::string, value);
+    }
+
+    void datetime(string_ref_t value) {
+        push_string(tape_type_t::datetime, value);
+    }
+
+    void integer(std::int64_t value) {
+        push(tape_type_t::integer, 0);
+        m_tape.push_back(static_cast<std::uint64_t>(value));
+    }
+
+    void floating_point(double value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        push(tape_type_t::floating_point, 0);
+        m_tape.push_back(bits);
+    }
+
+    void symbol(string_ref_t value) {
+        push_string(tape_type_t::symbol, value);
+    }
+
+private:
+    void push(tape_type_t type, std::uint64_t payload) {
+        m_tape.push_back(tape_word(type, payload));
+    }
+
+    void push_string(tape_type_t type, string_ref_t value) {
+        std::uint32_t size = static_cast<std::uint32_t>(value.size());
+        push(type, m_strings.size());
+        m_strings.append(reinterpret_cast<const char *>(&size), sizeof(size));
+        m_strings.append(value.data(), value.size());
+        m_strings.push_back('\0');
+    }
+
+    void close(tape_type_t type, std::size_t size) {
+        m_tape[m_open.back()] |= m_tape.size();
+        m_open.pop_back();
+        push(type, size);
+    }
+
+    // Number of elements of an unfinished array or inline table, it's used only when the parser stops.
+    std::size_t count_elements(std::size_t start) const {
+        bool is_array = tape_type(m_tape[start]) == tape_type_t::start_array;
+        std::size_t count = 0;
+
+        for (std::size_t index = start + 1; index < m_tape.size(); index = tape_next(m_tape, index)) {
+            if (is_array || tape_type(m_tape[index]) == tape_type_t::key) {
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+    // Sets the end of the current section, if it's a header.
+    void finish_section() {
+        if (m_section != 0) {
+            m_tape[m_section] |= m_tape.size();
+        }
+    }
+
+    void header(tape_type_t type, key_iterator_t begin, key_iterator_t end) {
+        finish_section();
+        m_section = m_tape.size();
+        push(type, 0);
+        m_tape.push_back(static_cast<std::uint64_t>(end - begin));
+
+        for (; begin != end; ++begin) {
+            push_string(tape_type_t::key, *begin);
+        }
+    }
+
+private:
+    std::vector<std::uint64_t> &m_tape;
+    std::string &m_strings;
+    std::vector<std::size_t> m_open;
+    // Index of the current header, 0 before the first one.
+    std::size_t m_section;
+};
+
+
+} // namespace detail
+
+
+/*! Parse a TOML document from a buffer into a loltoml::tape_document_t.
+ *
+ * \param[in] begin Pointer to the first byte of the document. It must be utf-8 encoded.
+ * \param[in] end Pointer past the last byte of the document.
+ * \param[in] options Features to enable, see loltoml::parse_options_t.
+ * \throws loltoml::parser_error_t if the buffer contains an invalid TOML document.
+ */
+inline tape_document_t parse_tape(const char *begin, const char *end, const parse_options_t &options = parse_options_t()) {
+    std::vector<std::uint64_t> tape;
+    std::string strings;
+    // Rough estimates to avoid most of the reallocations.
+    tape.reserve(static_cast<std::size_t>(end - begin) / 8 + 2);
+    strings.reserve(static_cast<std::size_t>(end - begin) / 2);
+
+    detail::tape_builder_t builder(tape, strings);
+    parse(begin, end, builder, options);
+
+    return tape_document_t(std::move(tape), std::move(strings));
+}
+
+
+/*! Parse a TOML document from a stream into a loltoml::tape_document_t.
+ *
+ * \param[in, out] input Stream containing a TOML document. It must be utf-8 encoded.
+ * \param[in] options Features to enable, see loltoml::parse_options_t.
+ * \throws loltoml::parser_error_t if the input contains an invalid TOML document.
+ * \throws loltoml::stream_error_t if input.bad() becomes true.
+ */
+inline tape_document_t parse_tape(std::istream &input, const parse_options_t &options = parse_options_t()) {
+    std::vector<std::uint64_t> tape;
+    std::string strings;
+    detail::tape_builder_t builder(tape, strings);
+    parse(input, builder, options);
+
+    return tape_document_t(std::move(tape), std::move(strings));
+}
+
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_TAPE_DOCUMENT_HPP
@@ -0,0 +1,64 @@
+#ifndef LOLTOML_VALIDATE_HPP
+#define LOLTOML_VALIDATE_HPP
+
+#include "loltoml/detail/common.hpp"
+#include "loltoml/detail/null_handler.hpp"
+#include "loltoml/error.hpp"
+#include "loltoml/parse.hpp"
+#include "loltoml/parse_options.hpp"
+
+#include <cstddef>
+#include <string>
+
+LOLTOML_OPEN_NAMESPACE
+
+
+//! Result of loltoml::validate().
+struct validation_result_t {
+    validation_result_t() :
+        valid(true),
+        error_offset(0)
+    { }
+
+    //! True if the document is valid.
+    bool valid;
+    //! Position of the first error. Meaningful only if the document is invalid.
+    std::size_t error_offset;
+    //! Message describing the first error. Empty if the document is valid.
+    std::string error_message;
+};
+
+
+/*! Check that a buffer contains a valid TOML document without producing any SAX-events.
+ *
+ * Runs the same grammar as loltoml::parse(), so it accepts exactly the same documents and reports the same errors,
+ * but doesn't build keys, strings, comments and table paths.
+ *
+ * \param[in] begin Pointer to the first byte of the document.
+ * \param[in] end Pointer past the last byte of the document.
+ * \param[in] options Features to enable, see loltoml::parse_options_t.
+ * \returns Whether the document is valid and the first error otherwise.
+ * \throws std::bad_alloc
+ */
+inline validation_result_t validate(const char *begin,
+                                    const char *end,
+                                    const parse_options_t &options = parse_options_t())
+{
+    validation_result_t result;
+    detail::null_handler_t handler;
+
+    try {
+        parse(begin, end, handler, options);
+    } catch (const parser_error_t &e) {
+        result.valid = false;
+        result.error_offset = e.offset();
+        result.error_message = e.message();
+    }
+
+    return result;
+}
+
+
+LOLTOML_CLOSE_NAMESPACE
+
+#endif // LOLTOML_VALIDATE_HPP
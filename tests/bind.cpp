@@ -0,0 +1,269 @@
+#include "common.hpp"
+
+#include "loltoml/bind.hpp"
+
+#include <sstream>
+
+
+namespace {
+    struct tls_t {
+        bool enabled;
+        std::string certificate;
+    };
+
+    LOLTOML_BIND(tls_t, enabled, certificate);
+
+    struct server_t {
+        std::string host;
+        std::uint16_t port;
+        tls_t tls;
+    };
+
+    LOLTOML_BIND(server_t, host, port, tls);
+
+    struct config_t {
+        std::string name;
+        std::int64_t workers;
+        double timeout;
+        float ratio;
+        bool verbose;
+        loltoml::datetime_t started;
+        std::vector<std::int32_t> ports;
+        std::vector<std::vector<std::string>> groups;
+        server_t primary;
+        std::vector<server_t> servers;
+    };
+
+    LOLTOML_BIND(config_t, name, workers, timeout, ratio, verbose, started, ports, groups, primary, servers);
+
+    struct defaults_t {
+        int retries = 3;
+        std::string mode = "fast";
+    };
+
+    LOLTOML_BIND(defaults_t, retries, mode);
+
+    struct leaf_t {
+        int value;
+    };
+
+    LOLTOML_BIND(leaf_t, value);
+
+    struct branch_t {
+        std::vector<leaf_t> b = {leaf_t{-1}, leaf_t{-2}};
+    };
+
+    LOLTOML_BIND(branch_t, b);
+
+    struct tree_t {
+        std::vector<branch_t> a;
+    };
+
+    LOLTOML_BIND(tree_t, a);
+
+    config_t parse_config(const std::string &document) {
+        return loltoml::parse_into<config_t>(document.data(), document.data() + document.size());
+    }
+
+    void test_error(const std::string &document) {
+        SCOPED_TRACE("bind '" + document + "'");
+        EXPECT_THROW(parse_config(document), loltoml::bind_error_t);
+    }
+}
+
+
+TEST(Bind, Scalars) {
+    config_t config = parse_config(
+        "name = \"gateway\"\n"
+        "workers = 8\n"
+        "timeout = 2.5\n"
+        "ratio = 1\n"
+        "verbose = true\n"
+        "started = 1979-05-27T07:32:00Z\n"
+    );
+
+    EXPECT_EQ("gateway", config.name);
+    EXPECT_EQ(8, config.workers);
+    EXPECT_EQ(2.5, config.timeout);
+    EXPECT_EQ(1.0f, config.ratio);
+    EXPECT_TRUE(config.verbose);
+    EXPECT_EQ(296638320, config.started.epoch_seconds);
+    EXPECT_TRUE(config.ports.empty());
+}
+
+
+TEST(Bind, Tables) {
+    config_t config = parse_config(
+        "primary = { host = \"a.example\", port = 80, tls = { enabled = false } }\n"
+        "[[servers]]\n"
+        "host = \"b.example\"\n"
+        "port = 443\n"
+        "[servers.tls]\n"
+        "enabled = true\n"
+        "certificate = \"b.pem\"\n"
+        "[[servers]]\n"
+        "host = \"c.example\"\n"
+        "[primary.tls]\n"
+        "certificate = \"a.pem\"\n"
+    );
+
+    EXPECT_EQ("a.example", config.primary.host);
+    EXPECT_EQ(80, config.primary.port);
+    EXPECT_FALSE(config.primary.tls.enabled);
+    EXPECT_EQ("a.pem", config.primary.tls.certificate);
+
+    ASSERT_EQ(2u, config.servers.size());
+    EXPECT_EQ("b.example", config.servers[0].host);
+    EXPECT_EQ(443, config.servers[0].port);
+    EXPECT_TRUE(config.servers[0].tls.enabled);
+    EXPECT_EQ("b.pem", config.servers[0].tls.certificate);
+    EXPECT_EQ("c.example", config.servers[1].host);
+    EXPECT_EQ(0, config.servers[1].port);
+}
+
+
+TEST(Bind, Arrays) {
+    config_t config = parse_config(
+        "ports = [80, 443]\n"
+        "groups = [[\"a\", \"b\"], [], [\"c\"]]\n"
+        "servers = [{ host = \"a\" }, { host = \"b\", port = 1 }]\n"
+    );
+
+    EXPECT_EQ((std::vector<std::int32_t>{80, 443}), config.ports);
+    EXPECT_EQ((std::vector<std::vector<std::string>>{{"a", "b"}, {}, {"c"}}), config.groups);
+    ASSERT_EQ(2u, config.servers.size());
+    EXPECT_EQ("a", config.servers[0].host);
+    EXPECT_EQ("b", config.servers[1].host);
+    EXPECT_EQ(1, config.servers[1].port);
+}
+
+
+TEST(Bind, UnknownKeysAreSkipped) {
+    config_t config = parse_config(
+        "unknown = [1, \"mixed\", {}]\n"
+        "name = \"x\"\n"
+        "primary = { unknown = 1, port = 2 }\n"
+        "[unknown]\n"
+        "workers = \"not an integer\"\n"
+        "[primary.unknown]\n"
+        "port = \"not an integer\"\n"
+        "[[unknown.servers]]\n"
+        "workers = 5\n"
+    );
+
+    EXPECT_EQ("x", config.name);
+    EXPECT_EQ(2, config.primary.port);
+    EXPECT_EQ(0, config.workers);
+}
+
+
+TEST(Bind, Defaults) {
+    std::string document = "mode = \"safe\"";
+    defaults_t defaults = loltoml::parse_into<defaults_t>(document.data(), document.data() + document.size());
+
+    EXPECT_EQ(3, defaults.retries);
+    EXPECT_EQ("safe", defaults.mode);
+}
+
+
+TEST(Bind, Reload) {
+    config_t config = parse_config("workers = 4\nports = [1, 2]\n[[servers]]\nhost = \"a\"\n[[servers]]\nhost = \"b\"");
+
+    std::string document = "ports = [3]\n[[servers]]\nhost = \"c\"";
+    loltoml::parse_into(document.data(), document.data() + document.size(), config);
+
+    EXPECT_EQ(4, config.workers);
+    EXPECT_EQ((std::vector<std::int32_t>{3}), config.ports);
+    ASSERT_EQ(1u, config.servers.size());
+    EXPECT_EQ("c", config.servers[0].host);
+}
+
+
+TEST(Bind, NestedArraysOfTables) {
+    std::string document =
+        "[[a]]\n"
+        "[[a.b]]\n"
+        "value = 1\n"
+        "[[a]]\n"
+        "[[a.b]]\n"
+        "value = 2\n"
+        "[[a.b]]\n"
+        "value = 3\n"
+        "[[a]]\n";
+
+    // Every element of a gets its own b replaced, even if it reuses the storage of an earlier element.
+    for (std::size_t reserved = 0; reserved < 3; ++reserved) {
+        tree_t tree;
+        tree.a.reserve(reserved);
+        loltoml::parse_into(document.data(), document.data() + document.size(), tree);
+
+        ASSERT_EQ(3u, tree.a.size());
+        ASSERT_EQ(1u, tree.a[0].b.size());
+        EXPECT_EQ(1, tree.a[0].b[0].value);
+        ASSERT_EQ(2u, tree.a[1].b.size());
+        EXPECT_EQ(2, tree.a[1].b[0].value);
+        EXPECT_EQ(3, tree.a[1].b[1].value);
+        EXPECT_EQ(2u, tree.a[2].b.size());
+    }
+
+    // [[a]] clears the element [[a.b]] went through and appends a new one at the same address.
+    tree_t tree;
+    tree.a.resize(1);
+    document = "[[a.b]]\nvalue = 1\n[[a]]\n[[a.b]]\nvalue = 2\n";
+    loltoml::parse_into(document.data(), document.data() + document.size(), tree);
+
+    ASSERT_EQ(1u, tree.a.size());
+    ASSERT_EQ(1u, tree.a[0].b.size());
+    EXPECT_EQ(2, tree.a[0].b[0].value);
+}
+
+
+TEST(Bind, Stream) {
+    std::istringstream input("name = \"stream\"\n[primary]\nport = 8080");
+    config_t config = loltoml::parse_into<config_t>(input);
+
+    EXPECT_EQ("stream", config.name);
+    EXPECT_EQ(8080, config.primary.port);
+}
+
+
+TEST(Bind, Mismatches) {
+    test_error("name = 1");
+    test_error("workers = \"1\"");
+    test_error("workers = 1.5");
+    test_error("verbose = 1");
+    test_error("started = \"1979-05-27\"");
+    test_error("ports = 1");
+    test_error("ports = [\"1\"]");
+    test_error("name = [\"1\"]");
+    test_error("primary = 1");
+    test_error("name = { a = 1 }");
+    test_error("[name]");
+    test_error("[[name]]");
+    test_error("[[ports]]");
+    test_error("[servers.tls]");
+    test_error("name = other");
+}
+
+
+TEST(Bind, OutOfRange) {
+    test_error("primary = { port = 65536 }");
+    test_error("primary = { port = -1 }");
+    test_error("ports = [2147483648]");
+
+    config_t config = parse_config("primary = { port = 65535 }\nports = [-2147483648]");
+    EXPECT_EQ(65535, config.primary.port);
+    EXPECT_EQ(-2147483648LL, config.ports[0]);
+}
+
+
+TEST(Bind, ErrorMessage) {
+    std::string document = "[primary]\nport = \"http\"";
+
+    try {
+        parse_config(document);
+        ADD_FAILURE();
+    } catch (const loltoml::bind_error_t &error) {
+        EXPECT_EQ(std::string("Field \"port\" cannot hold a string"), error.message());
+    }
+}
@@ -0,0 +1,113 @@
+#include "common.hpp"
+
+#include <sstream>
+
+
+namespace {
+    std::vector<sax_event_t> parse_stream(const std::string &document) {
+        std::istringstream input(document);
+        events_aggregator_t handler;
+
+        loltoml::parse(input, handler);
+
+        return handler.events;
+    }
+
+    std::vector<sax_event_t> parse_buffer(const std::string &document) {
+        events_aggregator_t handler;
+
+        loltoml::parse(document.data(), document.data() + document.size(), handler);
+
+        return handler.events;
+    }
+
+    std::size_t stream_error_offset(const std::string &document) {
+        std::istringstream input(document);
+        events_aggregator_t handler;
+
+        try {
+            loltoml::parse(input, handler);
+        } catch (const loltoml::parser_error_t &e) {
+            return e.offset();
+        }
+
+        ADD_FAILURE() << "Document parsed successfully";
+        return 0;
+    }
+
+    std::size_t buffer_error_offset(const std::string &document) {
+        events_aggregator_t handler;
+
+        try {
+            loltoml::parse(document.data(), document.data() + document.size(), handler);
+        } catch (const loltoml::parser_error_t &e) {
+            return e.offset();
+        }
+
+        ADD_FAILURE() << "Document parsed successfully";
+        return 0;
+    }
+}
+
+
+TEST(Buffer, EmptyDocument) {
+    events_aggregator_t handler;
+
+    loltoml::parse(static_cast<const char *>(nullptr), static_cast<const char *>(nullptr), handler);
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, handler.events);
+}
+
+TEST(Buffer, DocumentIsNotNullTerminated) {
+    const char document[] = {'k', 'e', 'y', ' ', '=', ' ', '"', 'v', '"'};
+    events_aggregator_t handler;
+
+    loltoml::parse(document, document + sizeof(document), handler);
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::key, "key"},
+        {sax_event_t::string, "v"},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, handler.events);
+}
+
+TEST(Buffer, SameEventsAsStream) {
+    std::string document =
+        "# comment\n"
+        "key = \"value\\t\\u00e9\"\n"
+        "[table . \"quoted key\"]\r\n"
+        "literal = 'C:\\path'\n"
+        "multiline = \"\"\"\none\\\n   two\"\"\"\n"
+        "multiline_literal = '''\nraw\n'''\n"
+        "[[array.table]] # trailing comment\n"
+        "inline = { x = 1, y = true }\n"
+        "array = [\n  [1, 2],\n  [\"x\"], # comment\n]\n"
+        "symbol = key";
+
+    EXPECT_EQ(parse_stream(document), parse_buffer(document));
+}
+
+TEST(Buffer, SameErrorOffsetsAsStream) {
+    const char *documents[] = {
+        "# this comment ends here -->\b and after that will be an error",
+        "key = \"unterminated",
+        "key = [1, 2",
+        "[table",
+        "key = { a = 1, b = 2",
+        "key = 'abc\x01'",
+        "key = \"\\q\""
+    };
+
+    for (std::size_t i = 0; i < sizeof(documents) / sizeof(documents[0]); ++i) {
+        SCOPED_TRACE(documents[i]);
+        EXPECT_EQ(stream_error_offset(documents[i]), buffer_error_offset(documents[i]));
+    }
+}
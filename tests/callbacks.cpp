@@ -0,0 +1,105 @@
+#include "common.hpp"
+
+#include <sstream>
+
+
+namespace {
+    // Handles only integers, everything else is skipped.
+    struct integers_collector_t {
+        std::vector<std::int64_t> integers;
+
+        void integer(std::int64_t value) {
+            integers.push_back(value);
+        }
+    };
+
+    // Handles only keys and tables; counts how many times it's called.
+    struct structure_collector_t {
+        std::vector<std::string> keys;
+        std::size_t tables = 0;
+
+        void key(const std::string &key) {
+            keys.push_back(key);
+        }
+
+        void table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
+            ++tables;
+            keys.insert(keys.end(), begin, end);
+        }
+    };
+
+    struct empty_handler_t { };
+
+    const char *document =
+        "# comment\n"
+        "a = 1\n"
+        "\"b\\tc\" = \"string\"\n"
+        "[table.\"sub\\u00e9\"]\n"
+        "d = [2, 3] # comment\n"
+        "e = { f = 4.5, g = true, h = symbol }\n"
+        "[[array]]\n"
+        "i = -5\n";
+}
+
+
+TEST(Callbacks, OnlyIntegers) {
+    std::istringstream input(document);
+    integers_collector_t handler;
+
+    loltoml::parse(input, handler);
+
+    std::vector<std::int64_t> expected = {1, 2, 3, -5};
+    EXPECT_EQ(expected, handler.integers);
+}
+
+TEST(Callbacks, OnlyKeysAndTables) {
+    std::istringstream input(document);
+    structure_collector_t handler;
+
+    loltoml::parse(input, handler);
+
+    std::vector<std::string> expected = {"a", "b\tc", "table", "sub\xc3\xa9", "d", "e", "f", "g", "h", "i"};
+    EXPECT_EQ(expected, handler.keys);
+    EXPECT_EQ(1u, handler.tables);
+}
+
+TEST(Callbacks, NoCallbacks) {
+    std::string data(document);
+    empty_handler_t handler;
+
+    loltoml::parse(data.data(), data.data() + data.size(), handler);
+}
+
+TEST(Callbacks, SkippedEventsAreStillValidated) {
+    const char *documents[] = {
+        "# comment with a control character \x01",
+        "\"\" = 1",
+        "a = \"\\q\"",
+        "[table.\"\"]",
+        "a = [1, \"two\"]",
+        "a = 9223372036854775808"
+    };
+
+    for (std::size_t i = 0; i < sizeof(documents) / sizeof(documents[0]); ++i) {
+        SCOPED_TRACE(documents[i]);
+
+        std::string data(documents[i]);
+        empty_handler_t handler;
+
+        EXPECT_THROW(loltoml::parse(data.data(), data.data() + data.size(), handler), loltoml::parser_error_t);
+    }
+}
+
+TEST(Callbacks, Detection) {
+    typedef loltoml::detail::callbacks_t<structure_collector_t> callbacks;
+
+    EXPECT_TRUE(callbacks::has_key);
+    EXPECT_TRUE(callbacks::has_table);
+    EXPECT_FALSE(callbacks::has_array_table);
+    EXPECT_FALSE(callbacks::has_comment);
+    EXPECT_FALSE(callbacks::has_integer);
+    EXPECT_FALSE(callbacks::discards_tokens);
+
+    EXPECT_TRUE(loltoml::detail::callbacks_t<integers_collector_t>::discards_tokens);
+    EXPECT_TRUE(loltoml::detail::callbacks_t<events_aggregator_t>::has_datetime);
+}
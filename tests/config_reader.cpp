@@ -0,0 +1,150 @@
+#include "common.hpp"
+
+#include "../examples/toml_handler.h"
+
+#include <sstream>
+#include <stdexcept>
+
+
+namespace {
+    ConfigReader::FlatConfig parse_flat(const std::string &document) {
+        std::istringstream input(document);
+        return ConfigReader::parseFlat(input);
+    }
+
+    std::map<std::string, ConfigReader::TOMLValue> parse_map(const std::string &document) {
+        std::istringstream input(document);
+        return ConfigReader::parse(input);
+    }
+
+    std::int64_t integer(const ConfigReader::FlatConfig &config, const std::string &key) {
+        return config.at(key);
+    }
+
+    std::string to_string(const ConfigReader::TOMLValue &value) {
+        std::ostringstream output;
+        output << value;
+        return output.str();
+    }
+
+    // Message of the error thrown by parseFlat() for the document.
+    std::string error(const std::string &document) {
+        try {
+            parse_flat(document);
+        } catch (const std::runtime_error &e) {
+            return e.what();
+        }
+
+        ADD_FAILURE() << "Document parsed successfully";
+        return std::string();
+    }
+}
+
+
+TEST(FlatConfig, Lookup) {
+    ConfigReader::FlatConfig config = parse_flat("b = 2\na = 'x'\nc = 1.5\nb = 3\n");
+
+    EXPECT_EQ(3u, config.size());
+    EXPECT_FALSE(config.empty());
+    EXPECT_EQ(3, integer(config, "b"));
+    EXPECT_EQ("x", static_cast<std::string>(config.at("a")));
+    EXPECT_EQ(1.5, static_cast<double>(*config.find("c")));
+    EXPECT_EQ(1u, config.count("a"));
+    EXPECT_EQ(0u, config.count("d"));
+    EXPECT_EQ(nullptr, config.find("d"));
+    EXPECT_THROW(config.at("d"), std::out_of_range);
+
+    std::vector<std::string> keys;
+    config.forEach([&keys](loltoml::string_ref_t key, const ConfigReader::TOMLValue &) {
+        keys.push_back(key.str());
+    });
+
+    EXPECT_EQ((std::vector<std::string>{"b", "a", "c"}), keys);
+    EXPECT_TRUE(parse_flat("# empty\n").empty());
+}
+
+
+TEST(FlatConfig, SameValuesAsMap) {
+    std::string document =
+        "first = true\n"
+        "second = first\n"
+        "first = false\n"
+        "s = \"multi\\nline\"\n"
+        "t = s\n"
+        "d = 1979-05-27T07:32:00Z\n"
+        "i = 42\n"
+        "i = d\n";
+
+    std::map<std::string, ConfigReader::TOMLValue> expected = parse_map(document);
+    ConfigReader::FlatConfig config = parse_flat(document);
+
+    ASSERT_EQ(expected.size(), config.size());
+
+    for (const auto &pair : expected) {
+        ASSERT_NE(nullptr, config.find(pair.first)) << pair.first;
+        EXPECT_EQ(to_string(pair.second), to_string(*config.find(pair.first))) << pair.first;
+    }
+
+    EXPECT_FALSE(static_cast<bool>(config.at("first")));
+    EXPECT_TRUE(static_cast<bool>(config.at("second")));
+}
+
+
+TEST(FlatConfig, SymbolsShareValues) {
+    ConfigReader::FlatConfig config = parse_flat("blob = 'large'\na = blob\nb = a\nblob = 'other'\n");
+
+    EXPECT_EQ(config.find("a"), config.find("b"));
+    EXPECT_NE(config.find("a"), config.find("blob"));
+    EXPECT_EQ("large", static_cast<std::string>(config.at("b")));
+}
+
+
+TEST(FlatConfig, ForwardReferences) {
+    ConfigReader::FlatConfig config = parse_flat(
+        "second = first\n"
+        "first = true\n"
+        "third = first\n"
+        "first = false\n");
+
+    EXPECT_FALSE(static_cast<bool>(config.at("second")));
+    EXPECT_TRUE(static_cast<bool>(config.at("third")));
+
+    // Chains are resolved in order of their dependencies, not of the document.
+    config = parse_flat("a = b\nb = c\nc = 1\nd = a\ne = d\nc = 2\n");
+
+    for (const char *key : {"a", "b", "c", "d", "e"}) {
+        EXPECT_EQ(2, integer(config, key)) << key;
+    }
+
+    EXPECT_EQ(config.find("a"), config.find("e"));
+}
+
+
+TEST(FlatConfig, ReferencesToPendingSymbols) {
+    // c gets the value a has where c is defined: the value of b, not the later value of a.
+    ConfigReader::FlatConfig config = parse_flat("a = b\nc = a\na = 5\nb = 1\n");
+
+    EXPECT_EQ(5, integer(config, "a"));
+    EXPECT_EQ(1, integer(config, "b"));
+    EXPECT_EQ(1, integer(config, "c"));
+}
+
+
+TEST(FlatConfig, DefinedKeysAreKept) {
+    ConfigReader::FlatConfig config = parse_flat("a = 1\nb = 2\na = b\n");
+
+    EXPECT_EQ(1, integer(config, "a"));
+    EXPECT_EQ("Identifier \"c\" on right hand side of =, but undefined.", error("a = 1\na = c\n"));
+}
+
+
+TEST(FlatConfig, Errors) {
+    EXPECT_EQ("Identifier \"x\" on right hand side of =, but undefined.", error("a = 1\nb = x\n"));
+    EXPECT_EQ("Identifier \"x\" on right hand side of =, but undefined.", error("a = b\nb = x\n"));
+    EXPECT_EQ("Symbols reference each other: a -> a.", error("a = a\n"));
+    EXPECT_EQ("Symbols reference each other: a -> b -> a.", error("a = b\nb = a\n"));
+    EXPECT_EQ("Symbols reference each other: a -> b -> c -> a.", error("a = b\nb = c\nc = a\n"));
+    EXPECT_EQ("Symbols reference each other: b -> c -> b.", error("a = b\nb = c\nc = b\n"));
+
+    EXPECT_THROW(parse_flat("[table]\na = 1\n"), ConfigReader::UnsupportedTOMLExpressionError);
+}
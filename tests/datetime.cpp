@@ -1,5 +1,7 @@
 #include "common.hpp"
 
+#include "loltoml/datetime.hpp"
+
 #include <sstream>
 
 
@@ -32,60 +34,219 @@ namespace {
 
         EXPECT_THROW(loltoml::parse(input, handler), loltoml::parser_error_t);
     }
+
+    struct datetime_handler_t {
+        std::vector<loltoml::datetime_t> values;
+
+        void datetime(const loltoml::datetime_t &value) {
+            values.push_back(value);
+        }
+    };
+
+    loltoml::datetime_t parse_value(const std::string &str) {
+        std::string document = "key = " + str;
+        datetime_handler_t handler;
+        loltoml::parse(document.data(), document.data() + document.size(), handler);
+
+        EXPECT_EQ(1u, handler.values.size());
+        return handler.values.empty() ? loltoml::datetime_t() : handler.values[0];
+    }
+
+    std::string to_string(const loltoml::datetime_t &value) {
+        std::ostringstream output;
+        output << value;
+        return output.str();
+    }
 }
 
 
 TEST(Datetime, UTC) {
     test_parsing("1111-11-11T00:11:01Z");
-    test_parsing("0014-00-00t03:21:91Z");
+    test_parsing("0014-01-01t03:21:59Z");
     test_parsing("1971-11-11t00:11:01z");
     test_parsing("1971-01-11t00:11:01Z");
 }
 
 TEST(Datetime, Timezone) {
     test_parsing("1111-11-11T00:11:01+00:00");
-    test_parsing("0014-00-00t03:21:91-01:12");
-    test_parsing("1971-11-11t00:11:01+32:33");
+    test_parsing("0014-02-28t03:21:59-01:12");
+    test_parsing("1971-11-11t00:11:01+23:59");
 }
 
 TEST(Datetime, FractionalSeconds) {
     test_parsing("1111-11-11T00:11:01.0+00:00");
-    test_parsing("0014-00-00t03:21:91.2323-01:12");
-    test_parsing("1971-11-11t00:11:01.090239+32:33");
+    test_parsing("0014-02-28t03:21:59.2323-01:12");
+    test_parsing("1971-11-11t00:11:01.090239+23:59");
     test_parsing("1971-11-11t00:11:01.090239z");
 }
 
-TEST(Datetime, TimezoneCannotBeOmitted) {
-    test_error("1111-11-11T00:11:01.0");
-    test_error("0014-00-00t03:21:91");
-    test_error("1971-11-11t00:11:01.090239");
-    test_error("1971-11-11t00:11:01");
+TEST(Datetime, LocalDatetime) {
+    test_parsing("1111-11-11T00:11:01.0");
+    test_parsing("1971-11-11t00:11:01.090239");
+    test_parsing("1971-11-11t00:11:01");
 }
 
-TEST(Datetime, TimeCannotBeOmitted) {
-    test_error("1111-11-11");
-    test_error("0014-00-00t");
+TEST(Datetime, LocalDate) {
+    test_parsing("1111-11-11");
+    test_parsing("1979-05-27");
+
+    test_error("1979-05-27t");
     test_error("1971-11-11t+00:01");
+    test_error("1971-11-11Z");
 }
 
-TEST(Datetime, DateCannotBeOmitted) {
+TEST(Datetime, LocalTime) {
+    test_parsing("00:11:01");
+    test_parsing("07:32:00.999999");
+
+    // Times have no offset without a date.
     test_error("00:11:01.0+00:00");
-    test_error("t03:21:91.2323-01:12");
-    test_error("T00:11:01.090239+32:33");
     test_error("00:11:01.090239z");
-    test_error("t00:11:01.090239z");
-    test_error("00:11:01");
     test_error("00:11:01z");
+
+    test_error("t03:21:21.2323-01:12");
+    test_error("T00:11:01.090239+23:33");
+    test_error("t00:11:01.090239z");
 }
 
 TEST(Datetime, TCannotBeOmitted) {
     test_error("1111-11-1100:11:01.0+00:00");
-    test_error("0014-00-0003:21:91.2323-01:12");
-    test_error("1971-11-1100:11:01.090239+32:33");
+    test_error("0014-01-0103:21:21.2323-01:12");
+    test_error("1971-11-1100:11:01.090239+23:33");
     test_error("1971-11-1100:11:01.090239z");
 
     test_error("1111-11-11 00:11:01.0+00:00");
-    test_error("0014-00-00 03:21:91.2323-01:12");
-    test_error("1971-11-11 00:11:01.090239+32:33");
+    test_error("0014-01-01 03:21:21.2323-01:12");
+    test_error("1971-11-11 00:11:01.090239+23:33");
     test_error("1971-11-11 00:11:01.090239z");
 }
+
+TEST(Datetime, InvalidFormat) {
+    test_error("1979-5-27");
+    test_error("197-05-27");
+    test_error("1979-05-27T7:32:00");
+    test_error("1979-05-27T07:32");
+    test_error("07:32");
+    test_error("07:32:00.");
+    test_error("1979-05-27T07:32:00+07");
+    test_error("1979-05-27T07:32:00+0700");
+    test_error("+1979-05-27");
+    test_error("1_979-05-27");
+    test_error("1979-05-27T07:32:00Z1");
+}
+
+TEST(Datetime, OutOfRange) {
+    test_error("0014-00-00t03:21:21Z");
+    test_error("1979-13-01");
+    test_error("1979-04-31");
+    test_error("1979-02-29");
+    test_error("1900-02-29");
+    test_error("24:00:00");
+    test_error("00:60:00");
+    test_error("00:00:61");
+    test_error("1979-05-27T07:32:00+24:00");
+    test_error("1979-05-27T07:32:00-00:60");
+
+    test_parsing("2000-02-29");
+    test_parsing("1972-02-29");
+    // Leap seconds.
+    test_parsing("1972-06-30T23:59:60Z");
+}
+
+TEST(Datetime, InArrays) {
+    std::string document = "a = [1979-05-27, 07:32:00, 1979-05-27T07:32:00Z]\nb = [1979-05-27, 1]";
+    datetime_handler_t handler;
+
+    // Datetimes of all kinds have the same type, but not the same as integers.
+    EXPECT_THROW(loltoml::parse(document.data(), document.data() + document.size(), handler), loltoml::parser_error_t);
+    EXPECT_EQ(4u, handler.values.size());
+}
+
+TEST(Datetime, Values) {
+    loltoml::datetime_t offset = parse_value("1979-05-27T00:32:00.999999-07:00");
+    EXPECT_EQ(loltoml::datetime_kind_t::offset_datetime, offset.kind);
+    EXPECT_EQ(296638320, offset.epoch_seconds);
+    EXPECT_EQ(999999000u, offset.nanosecond);
+    EXPECT_EQ(-420, offset.offset_minutes);
+    EXPECT_EQ(1979, offset.year);
+    EXPECT_EQ(5, offset.month);
+    EXPECT_EQ(27, offset.day);
+    EXPECT_EQ(0, offset.hour);
+    EXPECT_EQ(32, offset.minute);
+    EXPECT_EQ(0, offset.second);
+    EXPECT_TRUE(offset.has_date() && offset.has_time() && offset.has_offset());
+
+    EXPECT_EQ(-1, parse_value("1969-12-31T23:59:59Z").epoch_seconds);
+    EXPECT_EQ(-62135596800, parse_value("0001-01-01T00:00:00Z").epoch_seconds);
+    EXPECT_EQ(253402300799, parse_value("9999-12-31T23:59:59Z").epoch_seconds);
+    EXPECT_EQ(123456789u, parse_value("00:00:00.1234567891").nanosecond);
+
+    loltoml::datetime_t local = parse_value("1979-05-27T07:32:00");
+    EXPECT_EQ(loltoml::datetime_kind_t::local_datetime, local.kind);
+    EXPECT_EQ(296638320, local.epoch_seconds);
+    EXPECT_FALSE(local.has_offset());
+
+    loltoml::datetime_t date = parse_value("2000-02-29");
+    EXPECT_EQ(loltoml::datetime_kind_t::local_date, date.kind);
+    EXPECT_EQ(951782400, date.epoch_seconds);
+    EXPECT_EQ(0, date.hour);
+    EXPECT_FALSE(date.has_time());
+
+    loltoml::datetime_t time = parse_value("07:32:00.5");
+    EXPECT_EQ(loltoml::datetime_kind_t::local_time, time.kind);
+    EXPECT_EQ(7 * 3600 + 32 * 60, time.epoch_seconds);
+    EXPECT_EQ(500000000u, time.nanosecond);
+    EXPECT_EQ(0, time.year);
+    EXPECT_FALSE(time.has_date());
+
+    // The same instant in different offsets.
+    EXPECT_EQ(parse_value("1979-05-27T07:32:00Z").epoch_seconds, parse_value("1979-05-27T10:02:00+02:30").epoch_seconds);
+}
+
+TEST(Datetime, ValueAndText) {
+    struct handler_t {
+        std::vector<std::string> texts;
+        std::size_t values = 0;
+
+        void datetime(const loltoml::datetime_t &, const std::string &text) {
+            ++values;
+            texts.push_back(text);
+        }
+
+        // Not called, the method with the text comes first.
+        void datetime(const loltoml::datetime_t &) {
+            ADD_FAILURE();
+        }
+    };
+
+    std::string document = "a = 1979-05-27T07:32:00.50Z\nb = 07:32:00";
+    handler_t handler;
+    loltoml::parse(document.data(), document.data() + document.size(), handler);
+
+    EXPECT_EQ((std::vector<std::string>{"1979-05-27T07:32:00.50Z", "07:32:00"}), handler.texts);
+    EXPECT_EQ(2u, handler.values);
+}
+
+TEST(Datetime, ParseAndWrite) {
+    const char *datetimes[] = {
+        "1979-05-27T07:32:00Z",
+        "1979-05-27T00:32:00.999999-07:00",
+        "1979-05-27T00:32:00+05:30",
+        "1979-05-27T07:32:00",
+        "1979-05-27",
+        "07:32:00.000000001",
+    };
+
+    for (const char *text: datetimes) {
+        loltoml::datetime_t value;
+        ASSERT_TRUE(loltoml::parse_datetime(text, value)) << text;
+        EXPECT_EQ(text, to_string(value));
+    }
+
+    loltoml::datetime_t value;
+    ASSERT_TRUE(loltoml::parse_datetime("1979-05-27t07:32:00.500+00:00", value));
+    EXPECT_EQ("1979-05-27T07:32:00.5Z", to_string(value));
+
+    EXPECT_FALSE(loltoml::parse_datetime("", value));
+    EXPECT_FALSE(loltoml::parse_datetime("1979-05-27 07:32:00", value));
+}
@@ -0,0 +1,250 @@
+#include "common.hpp"
+
+#include "loltoml/document.hpp"
+
+#include <sstream>
+
+
+namespace {
+    loltoml::document_t parse_document(const std::string &document) {
+        return loltoml::parse_document(document.data(), document.data() + document.size());
+    }
+}
+
+
+TEST(Document, Empty) {
+    loltoml::document_t document = parse_document("");
+
+    EXPECT_EQ(loltoml::value_type_t::table, document.root().type());
+    EXPECT_EQ(0u, document.root().size());
+    EXPECT_TRUE(document.root().begin() == document.root().end());
+    EXPECT_EQ(nullptr, document.find("key"));
+}
+
+
+TEST(Document, Values) {
+    loltoml::document_t document = parse_document(
+        "string = \"line\\n\"\n"
+        "literal = 'text'\n"
+        "integer = -42\n"
+        "float = 2.5\n"
+        "boolean = true\n"
+        "symbol = other\n"
+        "datetime = 1979-05-27T07:32:00Z\n"
+    );
+
+    ASSERT_EQ(7u, document.root().size());
+
+    const loltoml::value_t *value = document.find("string");
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(loltoml::value_type_t::string, value->type());
+    EXPECT_EQ("line\n", value->as_string());
+
+    value = document.find("literal");
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ("text", value->as_string());
+
+    value = document.find("integer");
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(loltoml::value_type_t::integer, value->type());
+    EXPECT_EQ(-42, value->as_integer());
+
+    value = document.find("float");
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(loltoml::value_type_t::floating_point, value->type());
+    EXPECT_EQ(2.5, value->as_floating_point());
+
+    value = document.find("boolean");
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(loltoml::value_type_t::boolean, value->type());
+    EXPECT_TRUE(value->as_boolean());
+
+    value = document.find("symbol");
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(loltoml::value_type_t::symbol, value->type());
+    EXPECT_EQ("other", value->as_string());
+
+    // Datetimes keep their text, loltoml::parse_datetime() converts it.
+    value = document.find("datetime");
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(loltoml::value_type_t::datetime, value->type());
+    EXPECT_EQ("1979-05-27T07:32:00Z", value->as_string());
+}
+
+
+TEST(Document, ArraysAndInlineTables) {
+    loltoml::document_t document = parse_document(
+        "matrix = [[1, 2], [3]]\n"
+        "point = { x = 1, y = { z = 'deep' } }\n"
+    );
+
+    const loltoml::value_t *matrix = document.find("matrix");
+    ASSERT_NE(nullptr, matrix);
+    ASSERT_EQ(loltoml::value_type_t::array, matrix->type());
+    ASSERT_EQ(2u, matrix->size());
+
+    std::vector<std::vector<std::int64_t>> elements;
+
+    for (const loltoml::member_t &row: *matrix) {
+        EXPECT_TRUE(row.key.empty());
+        elements.emplace_back();
+
+        for (const loltoml::member_t &element: row.value) {
+            elements.back().push_back(element.value.as_integer());
+        }
+    }
+
+    EXPECT_EQ((std::vector<std::vector<std::int64_t>>{{1, 2}, {3}}), elements);
+
+    const loltoml::value_t *point = document.find("point");
+    ASSERT_NE(nullptr, point);
+    ASSERT_EQ(loltoml::value_type_t::table, point->type());
+    EXPECT_EQ(2u, point->size());
+    EXPECT_EQ(1, point->find("x")->as_integer());
+    EXPECT_EQ("deep", point->find("y")->find("z")->as_string());
+}
+
+
+TEST(Document, Tables) {
+    loltoml::document_t document = parse_document(
+        "[a.b]\n"
+        "x = 1\n"
+        "[a]\n"
+        "y = 2\n"
+        "[[a.items]]\n"
+        "name = 'first'\n"
+        "[a.items.meta]\n"
+        "z = 3\n"
+        "[[a.items]]\n"
+        "name = 'second'\n"
+    );
+
+    const loltoml::value_t *a = document.find("a");
+    ASSERT_NE(nullptr, a);
+    ASSERT_EQ(3u, a->size());
+
+    std::vector<std::string> keys;
+
+    for (const loltoml::member_t &member: *a) {
+        keys.push_back(member.key.str());
+    }
+
+    EXPECT_EQ((std::vector<std::string>{"b", "y", "items"}), keys);
+    EXPECT_EQ(1, a->find("b")->find("x")->as_integer());
+    EXPECT_EQ(2, a->find("y")->as_integer());
+
+    const loltoml::value_t *items = a->find("items");
+    ASSERT_NE(nullptr, items);
+    ASSERT_EQ(loltoml::value_type_t::array, items->type());
+    ASSERT_EQ(2u, items->size());
+
+    loltoml::member_iterator_t item = items->begin();
+    EXPECT_EQ("first", item->value.find("name")->as_string());
+    EXPECT_EQ(3, item->value.find("meta")->find("z")->as_integer());
+    ++item;
+    EXPECT_EQ("second", item->value.find("name")->as_string());
+    EXPECT_EQ(nullptr, item->value.find("meta"));
+}
+
+
+TEST(Document, LargeTable) {
+    std::string text;
+
+    for (int i = 0; i < 1000; ++i) {
+        text += "key" + std::to_string(i) + " = " + std::to_string(i) + "\n";
+    }
+
+    loltoml::document_t document = parse_document(text);
+    ASSERT_EQ(1000u, document.root().size());
+
+    for (int i = 0; i < 1000; ++i) {
+        const loltoml::value_t *value = document.find("key" + std::to_string(i));
+        ASSERT_NE(nullptr, value);
+        EXPECT_EQ(i, value->as_integer());
+    }
+
+    EXPECT_EQ(nullptr, document.find("key1000"));
+
+    std::int64_t expected = 0;
+
+    for (const loltoml::member_t &member: document.root()) {
+        EXPECT_EQ(expected++, member.value.as_integer());
+    }
+}
+
+
+TEST(Document, Stream) {
+    std::istringstream input("[server]\nhost = \"localhost\"\n");
+    loltoml::document_t document = loltoml::parse_document(input);
+
+    ASSERT_NE(nullptr, document.find("server"));
+    EXPECT_EQ("localhost", document.find("server")->find("host")->as_string());
+}
+
+
+TEST(Document, DoesNotReferToInput) {
+    std::string text = "key = 'value'\n[table]\nother = \"x\"\n";
+    loltoml::document_t document = parse_document(text);
+    text.assign(text.size(), '#');
+
+    EXPECT_EQ("value", document.find("key")->as_string());
+    EXPECT_EQ("x", document.find("table")->find("other")->as_string());
+}
+
+
+TEST(Document, MoveAndClear) {
+    loltoml::document_t document = parse_document("key = 'value'\n");
+    EXPECT_GT(document.memory_usage(), 0u);
+
+    loltoml::document_t moved(std::move(document));
+    EXPECT_EQ(0u, document.memory_usage());
+    EXPECT_EQ(0u, document.root().size());
+    EXPECT_EQ("value", moved.find("key")->as_string());
+
+    document = std::move(moved);
+    EXPECT_EQ("value", document.find("key")->as_string());
+
+    document.clear();
+    EXPECT_EQ(0u, document.memory_usage());
+    EXPECT_EQ(nullptr, document.find("key"));
+}
+
+
+TEST(Document, BuilderIsReusable) {
+    loltoml::document_t document;
+    loltoml::document_builder_t builder(document);
+
+    std::string first = "a = 1\n";
+    loltoml::parse(first.data(), first.data() + first.size(), builder);
+    EXPECT_EQ(1, document.find("a")->as_integer());
+
+    std::string second = "b = 2\n";
+    loltoml::parse(second.data(), second.data() + second.size(), builder);
+    EXPECT_EQ(nullptr, document.find("a"));
+    EXPECT_EQ(2, document.find("b")->as_integer());
+}
+
+
+TEST(Document, Redefinitions) {
+    const char *documents[] = {
+        "a = 1\na = 2\n",
+        "t = { a = 1, a = 2 }\n",
+        "[a]\n[a]\n",
+        "[a.b]\n[a]\n[a.b]\n",
+        "[a]\nb = 1\n[a.b]\n",
+        "[a]\nb = 1\n[a.b.c]\n",
+        "a = { b = 1 }\n[a.c]\n",
+        "a = [1]\n[[a]]\n",
+        "[a]\n[[a]]\n",
+        "[[a]]\n[a]\n",
+        "[a.b]\n[a]\nb = 1\n",
+    };
+
+    for (const char *text: documents) {
+        EXPECT_THROW(parse_document(text), loltoml::document_error_t) << text;
+    }
+
+    // Keys of different tables and array elements are independent.
+    EXPECT_NO_THROW(parse_document("a = 1\n[t]\na = 1\n[[arr]]\na = 1\n[[arr]]\na = 1\n"));
+    EXPECT_NO_THROW(parse_document("arr = [{ a = 1 }, { a = 1 }]\n"));
+}
@@ -0,0 +1,114 @@
+#include "common.hpp"
+
+#include "loltoml/validate.hpp"
+
+#include <sstream>
+
+
+namespace {
+    loltoml::parse_options_t check_duplicates() {
+        loltoml::parse_options_t options;
+        options.check_duplicate_keys = true;
+        return options;
+    }
+
+    loltoml::validation_result_t validate(const std::string &document) {
+        return loltoml::validate(document.data(), document.data() + document.size(), check_duplicates());
+    }
+
+    void expect_error_at(const std::string &document, const std::string &at) {
+        SCOPED_TRACE(document);
+
+        loltoml::validation_result_t result = validate(document);
+        EXPECT_FALSE(result.valid);
+        EXPECT_EQ(document.rfind(at), result.error_offset) << result.error_message;
+
+        // Without the option the document is accepted.
+        EXPECT_TRUE(loltoml::validate(document.data(), document.data() + document.size()).valid);
+    }
+}
+
+
+TEST(DuplicateKeys, Valid) {
+    const char *documents[] = {
+        "a = 1\nb = 1\n",
+        "a = 1\n[t]\na = 1\n[t.u]\na = 1\n",
+        "[a.b]\nx = 1\n[a]\ny = 1\n",
+        "[[arr]]\na = 1\n[arr.sub]\na = 1\n[[arr]]\na = 1\n[arr.sub]\na = 1\n",
+        "[[a.b]]\n[[a.b]]\n[a.c]\n",
+        "arr = [{ a = 1, b = { a = 1 } }, { a = 1 }]\n",
+        "t = { a = 1, b = { a = 1 } }\nu = { a = 1 }\n",
+        "\"a b\" = 1\n\"a.b\" = 1\n[t.\"a.b\"]\n[t.a.b]\n",
+    };
+
+    for (const char *document: documents) {
+        loltoml::validation_result_t result = validate(document);
+        EXPECT_TRUE(result.valid) << document << result.error_message;
+    }
+}
+
+
+TEST(DuplicateKeys, Keys) {
+    expect_error_at("a = 1\na = 2\n", "a = 2");
+    expect_error_at("a = 1\n\"a\" = 2\n", "\"a\" = 2");
+    expect_error_at("[t]\na = 1\nb = 2\na = 3\n", "a = 3");
+    expect_error_at("t = { a = 1, a = 2 }\n", "a = 2");
+    expect_error_at("arr = [{ a = 1 }, { a = 1, a = 2 }]\n", "a = 2");
+    expect_error_at("[a.b]\n[a]\nb = 1\n", "b = 1");
+}
+
+
+TEST(DuplicateKeys, Tables) {
+    expect_error_at("[a]\n[a]\n", "[a]");
+    expect_error_at("[a.b]\n[a]\n[a.b]\n", "[a.b]");
+    expect_error_at("[a]\nb = 1\n[a.b]\n", "[a.b]");
+    expect_error_at("[a]\nb = 1\n[a.b.c]\n", "[a.b.c]");
+    expect_error_at("a = { b = 1 }\n[a.c]\n", "[a.c]");
+    expect_error_at("a = [1]\n[[a]]\n", "[[a]]");
+    expect_error_at("[a]\n[[a]]\n", "[[a]]");
+    expect_error_at("[[a]]\n[a]\n", "[a]");
+}
+
+
+TEST(DuplicateKeys, ErrorStopsEvents) {
+    std::string document = "[t]\na = 1\na = 2\n";
+    events_aggregator_t handler;
+
+    EXPECT_THROW(loltoml::parse(document.data(), document.data() + document.size(), handler, check_duplicates()),
+                 loltoml::parser_error_t);
+
+    // The duplicate key isn't passed to the handler.
+    ASSERT_FALSE(handler.events.empty());
+    EXPECT_EQ((sax_event_t{sax_event_t::integer, 1}), handler.events.back());
+}
+
+
+TEST(DuplicateKeys, Stream) {
+    std::istringstream input("[a]\n[b]\n[a]\n");
+    events_aggregator_t handler;
+
+    try {
+        loltoml::parse(input, handler, check_duplicates());
+        ADD_FAILURE() << "Document parsed successfully";
+    } catch (const loltoml::parser_error_t &e) {
+        EXPECT_EQ(8u, e.offset());
+    }
+}
+
+
+TEST(DuplicateKeys, ManyKeys) {
+    std::string document;
+
+    for (int table = 0; table < 100; ++table) {
+        document += "[[tables]]\n";
+
+        for (int key = 0; key < 100; ++key) {
+            document += "key" + std::to_string(key) + " = " + std::to_string(table) + "\n";
+        }
+    }
+
+    EXPECT_TRUE(validate(document).valid);
+
+    document += "key99 = 1\n";
+    expect_error_at(document, "key99 = 1");
+}
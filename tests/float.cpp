@@ -1,5 +1,6 @@
 #include "common.hpp"
 
+#include <cmath>
 #include <sstream>
 
 
@@ -21,6 +22,21 @@ namespace {
         EXPECT_EQ(sax_event_t(sax_event_t::finish_document), handler.events[3]);
     }
 
+    // Unlike test_parsing(), requires the correctly rounded value, not just a close one.
+    void test_exact(const std::string &str, double expected) {
+        SCOPED_TRACE("parse '" + str + "'");
+
+        std::istringstream input("key = " + str);
+        events_aggregator_t handler;
+
+        loltoml::parse(input, handler);
+
+        ASSERT_EQ(4, handler.events.size());
+        ASSERT_EQ(sax_event_t::floating_point, handler.events[2].type);
+        EXPECT_EQ(expected, handler.events[2].float_data);
+        EXPECT_EQ(std::signbit(expected), std::signbit(handler.events[2].float_data));
+    }
+
     void test_error(const std::string &str) {
         std::string scope = "test error when parse '" + str + "'";
         SCOPED_TRACE(scope);
@@ -150,6 +166,35 @@ TEST(Float, Overflow) {
     test_error("-1.0e1000");
 }
 
+TEST(Float, CorrectRounding) {
+    test_exact("-0.0", -0.0);
+    test_exact("0.1", 0.1);
+    test_exact("1e23", 1e23);
+    test_exact("9007199254740993.0", 9007199254740992.0);
+    test_exact("9007199254740995.0", 9007199254740996.0);
+    test_exact("1.7976931348623157e308", 1.7976931348623157e308);
+    test_exact("2.2250738585072011e-308", 2.2250738585072011e-308);
+    test_exact("7.038531e-26", 7.038531e-26);
+    test_exact("123_456.789_012e-3", 123.456789012);
+}
+
+TEST(Float, Subnormals) {
+    test_exact("4.9406564584124654e-324", 4.9406564584124654e-324);
+    test_exact("2.4703282292062328e-324", 4.9406564584124654e-324);
+    test_exact("2.4703282292062327e-324", 0.0);
+    test_exact("2.2250738585072009e-308", 2.2250738585072009e-308);
+    test_exact("1e-400", 0.0);
+}
+
+TEST(Float, LongSignificands) {
+    test_exact("3.14159265358979323846264338327950288", 3.14159265358979323846264338327950288);
+    test_exact("123456789012345678901234567890.0", 123456789012345678901234567890.0);
+    test_exact("0.000000000000000000000000000000000000000001e300", 1e258);
+    // Exactly halfway between two doubles: only the last digit decides how to round.
+    test_exact("9007199254740993.00000000000000000000001", 9007199254740994.0);
+    test_exact("9007199254740993.00000000000000000000000", 9007199254740992.0);
+}
+
 TEST(Float, InfNanAreNotSupported) {
     test_error("Inf");
     test_error("-Inf");
@@ -0,0 +1,157 @@
+#include "common.hpp"
+
+#include "loltoml/incremental_parser.hpp"
+
+
+namespace {
+    std::vector<sax_event_t> parse_whole(const std::string &document) {
+        events_aggregator_t handler;
+        loltoml::parse(document.data(), document.data() + document.size(), handler);
+        return handler.events;
+    }
+
+    // Feeds the document in pieces of the given size.
+    std::vector<sax_event_t> parse_in_pieces(const std::string &document, std::size_t piece_size) {
+        events_aggregator_t handler;
+        loltoml::incremental_parser_t<events_aggregator_t> parser(handler);
+
+        for (std::size_t position = 0; position < document.size(); position += piece_size) {
+            parser.feed(document.data() + position, std::min(piece_size, document.size() - position));
+        }
+
+        parser.finish();
+        return handler.events;
+    }
+
+    // Splits the document in two pieces at the given position.
+    std::vector<sax_event_t> parse_split(const std::string &document, std::size_t split) {
+        events_aggregator_t handler;
+        loltoml::incremental_parser_t<events_aggregator_t> parser(handler);
+
+        parser.feed(document.data(), split);
+        parser.feed(document.data() + split, document.size() - split);
+        parser.finish();
+
+        return handler.events;
+    }
+
+    std::size_t whole_error_offset(const std::string &document) {
+        events_aggregator_t handler;
+
+        try {
+            loltoml::parse(document.data(), document.data() + document.size(), handler);
+        } catch (const loltoml::parser_error_t &e) {
+            return e.offset();
+        }
+
+        ADD_FAILURE() << "Document parsed successfully";
+        return 0;
+    }
+
+    std::size_t pieces_error_offset(const std::string &document, std::size_t piece_size) {
+        events_aggregator_t handler;
+        loltoml::incremental_parser_t<events_aggregator_t> parser(handler);
+
+        try {
+            for (std::size_t position = 0; position < document.size(); position += piece_size) {
+                parser.feed(document.data() + position, std::min(piece_size, document.size() - position));
+            }
+
+            parser.finish();
+        } catch (const loltoml::parser_error_t &e) {
+            return e.offset();
+        }
+
+        ADD_FAILURE() << "Document parsed successfully";
+        return 0;
+    }
+
+    const std::string document =
+        "# comment with \"quotes\" and [brackets]\n"
+        "key = \"value \\\" with \\u00e9scapes # not a comment\"\n"
+        "empty = \"\"\n"
+        "empty_literal = ''\n"
+        "[table . \"quoted ] key\"]\r\n"
+        "literal = 'C:\\path [x]'\n"
+        "multiline = \"\"\"\none\\\n   two \"quoted\" \"\" ] \n\"\"\"\n"
+        "multiline_literal = '''\nraw ' '' [\n'''\n"
+        "[[array.table]] # trailing comment\n"
+        "inline = { x = 1, y = [true, false], z = { w = 'a' } }\n"
+        "array = [\n  [1, 2], # comment ]\n  [\"x\", \"]\"],\n\n]\n"
+        "float = 1.5e3\n"
+        "symbol = key";
+}
+
+
+TEST(Incremental, SameEventsForAnySplit) {
+    std::vector<sax_event_t> expected = parse_whole(document);
+
+    for (std::size_t split = 0; split <= document.size(); ++split) {
+        ASSERT_EQ(expected, parse_split(document, split)) << "split at " << split;
+    }
+}
+
+TEST(Incremental, SameEventsForAnyPieceSize) {
+    std::vector<sax_event_t> expected = parse_whole(document);
+
+    for (std::size_t piece_size = 1; piece_size <= document.size(); ++piece_size) {
+        ASSERT_EQ(expected, parse_in_pieces(document, piece_size)) << "piece size " << piece_size;
+    }
+}
+
+TEST(Incremental, EventsArriveWithCompleteExpressions) {
+    events_aggregator_t handler;
+    loltoml::incremental_parser_t<events_aggregator_t> parser(handler);
+
+    parser.feed("a = 1\nb = [\n", 12);
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::key, "a"},
+        {sax_event_t::integer, 1}
+    };
+
+    EXPECT_EQ(expected_events, handler.events);
+
+    parser.feed("2]\n", 3);
+    EXPECT_EQ(7u, handler.events.size());
+
+    parser.finish();
+    EXPECT_EQ(sax_event_t(sax_event_t::finish_document), handler.events.back());
+}
+
+TEST(Incremental, EmptyDocument) {
+    events_aggregator_t handler;
+    loltoml::incremental_parser_t<events_aggregator_t> parser(handler);
+
+    parser.finish();
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, handler.events);
+}
+
+TEST(Incremental, SameErrorOffsets) {
+    const char *documents[] = {
+        "a = 1\nb = \"unterminated\nc = 2\n",
+        "a = 1\n[table\nb = [1]\n",
+        "a = [1,\n2\n",
+        "a = { b = 1\n}\n",
+        "a = 1\nb = \"\\q\"\n",
+        "a = 1\n# comment \x01\n",
+        "a = \"\"\"\nunterminated",
+        "a = 1 b = 2\n"
+    };
+
+    for (std::size_t i = 0; i < sizeof(documents) / sizeof(documents[0]); ++i) {
+        SCOPED_TRACE(documents[i]);
+        std::size_t expected = whole_error_offset(documents[i]);
+
+        for (std::size_t piece_size = 1; piece_size < 8; ++piece_size) {
+            EXPECT_EQ(expected, pieces_error_offset(documents[i], piece_size)) << "piece size " << piece_size;
+        }
+    }
+}
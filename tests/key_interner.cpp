@@ -0,0 +1,123 @@
+#include "common.hpp"
+
+#include "loltoml/key_interner.hpp"
+
+#include <sstream>
+
+
+namespace {
+    // Records ids of keys, other events are ignored.
+    struct interned_keys_handler_t {
+        std::vector<std::uint32_t> ids;
+        std::vector<std::string> names;
+
+        void key(const loltoml::interned_key_t &key) {
+            ids.push_back(key.id);
+            names.push_back(key.name.str());
+        }
+    };
+
+    loltoml::parse_options_t interning(loltoml::key_interner_t &interner) {
+        loltoml::parse_options_t options;
+        options.key_interner = &interner;
+        return options;
+    }
+
+    const std::string document =
+        "name = 'a'\n"
+        "[server]\n"
+        "name = 'b'\n"
+        "\"port\" = 1\n"
+        "limits = { name = 'c', arr = [{ port = 2 }] }\n";
+}
+
+
+TEST(KeyInterner, Intern) {
+    loltoml::key_interner_t interner;
+
+    loltoml::interned_key_t a = interner.intern("a");
+    loltoml::interned_key_t b = interner.intern("b");
+    loltoml::interned_key_t empty = interner.intern("");
+
+    EXPECT_EQ(0u, a.id);
+    EXPECT_EQ(1u, b.id);
+    EXPECT_EQ(2u, empty.id);
+    EXPECT_EQ("a", a.name);
+    EXPECT_EQ(3u, interner.size());
+
+    std::string copy = "a";
+    EXPECT_EQ(a.id, interner.intern(copy).id);
+    EXPECT_EQ(a.name.data(), interner.intern(copy).name.data());
+    EXPECT_EQ(3u, interner.size());
+
+    EXPECT_EQ(1u, interner.find("b"));
+    EXPECT_EQ(static_cast<std::uint32_t>(loltoml::key_interner_t::npos), interner.find("c"));
+    EXPECT_EQ("b", interner.name(1));
+}
+
+
+TEST(KeyInterner, NamesAreStable) {
+    loltoml::key_interner_t interner;
+    loltoml::interned_key_t first = interner.intern("first");
+
+    for (int i = 0; i < 10000; ++i) {
+        interner.intern(std::to_string(i));
+    }
+
+    EXPECT_EQ(10001u, interner.size());
+    EXPECT_EQ(first.name.data(), interner.name(first.id).data());
+    EXPECT_EQ("first", interner.name(first.id));
+
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_EQ(static_cast<std::uint32_t>(i + 1), interner.find(std::to_string(i)));
+    }
+}
+
+
+TEST(KeyInterner, Parse) {
+    loltoml::key_interner_t interner;
+
+    interned_keys_handler_t handler;
+    loltoml::parse(document.data(), document.data() + document.size(), handler, interning(interner));
+
+    EXPECT_EQ((std::vector<std::string>{"name", "name", "port", "limits", "name", "arr", "port"}), handler.names);
+    EXPECT_EQ((std::vector<std::uint32_t>{0, 0, 1, 2, 0, 3, 1}), handler.ids);
+    EXPECT_EQ(4u, interner.size());
+
+    // The second document reuses the ids, and only adds its new keys.
+    interned_keys_handler_t second;
+    std::istringstream input("port = 3\nhost = 'x'\n");
+    loltoml::parse(input, second, interning(interner));
+
+    EXPECT_EQ((std::vector<std::uint32_t>{1, 4}), second.ids);
+    EXPECT_EQ(5u, interner.size());
+}
+
+
+TEST(KeyInterner, HandlersWithoutInternedKeys) {
+    loltoml::key_interner_t interner;
+
+    events_aggregator_t expected;
+    loltoml::parse(document.data(), document.data() + document.size(), expected);
+
+    events_aggregator_t handler;
+    loltoml::parse(document.data(), document.data() + document.size(), handler, interning(interner));
+
+    EXPECT_EQ(expected.events, handler.events);
+}
+
+
+TEST(KeyInterner, WithOtherOptions) {
+    loltoml::key_interner_t interner;
+    loltoml::parse_options_t options = interning(interner);
+    options.check_duplicate_keys = true;
+    options.stop_after_keys = {{"server", "port"}};
+
+    interned_keys_handler_t handler;
+    loltoml::parse(document.data(), document.data() + document.size(), handler, options);
+    EXPECT_EQ((std::vector<std::string>{"name", "name", "port"}), handler.names);
+
+    std::string duplicate = "a = 1\na = 2\n";
+    EXPECT_THROW(loltoml::parse(duplicate.data(), duplicate.data() + duplicate.size(), handler, options),
+                 loltoml::parser_error_t);
+}
@@ -0,0 +1,241 @@
+#include "common.hpp"
+
+#include "loltoml/key_schema.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+
+namespace {
+    constexpr const char *config_keys[] = {
+        "title",
+        "server.host",
+        "server.port",
+        "owner.name",
+        "owner.address.city",
+        "servers.host",
+        "servers.ports",
+        "matrix.value"
+    };
+
+    // Records indices of keys, other events are ignored.
+    struct schema_keys_handler_t {
+        std::vector<std::uint32_t> indices;
+        std::vector<std::string> names;
+
+        void key(const loltoml::schema_key_t &key) {
+            indices.push_back(key.index);
+            names.push_back(key.name.str());
+        }
+    };
+
+    // A handler dispatching on the schema, it skips the values of unknown keys.
+    struct config_handler_t {
+        std::string host;
+        std::int64_t port = 0;
+        std::vector<std::string> servers;
+        std::size_t unknown = 0;
+        std::uint32_t current = loltoml::key_schema_t::npos;
+
+        loltoml::action_t key(const loltoml::schema_key_t &key) {
+            current = key.index;
+
+            if (key.index == loltoml::key_schema_t::npos) {
+                ++unknown;
+                return loltoml::action_t::skip;
+            }
+
+            return loltoml::action_t::proceed;
+        }
+
+        void string(const std::string &value) {
+            switch (current) {
+                case loltoml::key_index(config_keys, "server.host"):
+                    host = value;
+                    break;
+                case loltoml::key_index(config_keys, "servers.host"):
+                    servers.push_back(value);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void integer(std::int64_t value) {
+            if (current == loltoml::key_index(config_keys, "server.port")) {
+                port = value;
+            }
+        }
+    };
+
+    const loltoml::key_schema_t &config_schema() {
+        static const loltoml::key_schema_t schema(config_keys);
+        return schema;
+    }
+
+    loltoml::parse_options_t with_schema(const loltoml::key_schema_t &schema) {
+        loltoml::parse_options_t options;
+        options.key_schema = &schema;
+        return options;
+    }
+
+    const std::uint32_t npos = loltoml::key_schema_t::npos;
+}
+
+
+static_assert(loltoml::key_index(config_keys, "title") == 0, "indices are positions in the list");
+static_assert(loltoml::key_index(config_keys, "matrix.value") == 7, "indices are positions in the list");
+
+
+TEST(KeySchema, Find) {
+    const loltoml::key_schema_t &schema = config_schema();
+
+    ASSERT_EQ(8u, schema.size());
+
+    for (std::uint32_t i = 0; i < schema.size(); ++i) {
+        EXPECT_EQ(config_keys[i], schema.path(i));
+        EXPECT_EQ(i, schema.find(config_keys[i]));
+    }
+
+    EXPECT_EQ(npos, schema.find("server"));
+    EXPECT_EQ(npos, schema.find("server.hos"));
+    EXPECT_EQ(npos, schema.find(""));
+}
+
+
+TEST(KeySchema, Empty) {
+    loltoml::key_schema_t schema((std::vector<std::string>()));
+
+    EXPECT_EQ(0u, schema.size());
+    EXPECT_EQ(npos, schema.find("title"));
+}
+
+
+TEST(KeySchema, Large) {
+    std::vector<std::string> paths;
+
+    for (int i = 0; i < 20000; ++i) {
+        paths.push_back("section_" + std::to_string(i % 100) + ".key_" + std::to_string(i));
+    }
+
+    loltoml::key_schema_t schema(paths);
+
+    for (std::uint32_t i = 0; i < paths.size(); ++i) {
+        ASSERT_EQ(i, schema.find(paths[i]));
+    }
+
+    EXPECT_EQ(npos, schema.find("section_0.key_20000"));
+}
+
+
+TEST(KeySchema, Duplicates) {
+    EXPECT_THROW(loltoml::key_schema_t(std::vector<std::string>{"a", "b.c", "a"}), std::invalid_argument);
+    EXPECT_THROW(loltoml::key_index(config_keys, "missing"), std::invalid_argument);
+}
+
+
+TEST(KeySchema, Parse) {
+    std::string document =
+        "title = 'x'\n"
+        "unknown = 1\n"
+        "owner = { name = 'a', address = { city = 'b', street = 'c' } }\n"
+        "[server]\n"
+        "host = 'h'\n"
+        "\"port\" = 1\n"
+        "title = 'y'\n"
+        "[[servers]]\n"
+        "host = 'a'\n"
+        "ports = [1, 2]\n"
+        "[[servers]]\n"
+        "host = 'b'\n"
+        "[other]\n"
+        "matrix = [[{ value = 1 }], [{ value = 2 }, { other = 3 }]]\n"
+        "[a]\n"
+        "matrix = [{ value = 1 }]\n";
+
+    schema_keys_handler_t handler;
+    loltoml::parse(document.data(), document.data() + document.size(), handler, with_schema(config_schema()));
+
+    std::vector<std::uint32_t> expected = {
+        0, npos,
+        npos, 3, npos, 4, npos,
+        1, 2, npos,
+        5, 6,
+        5,
+        npos, npos, npos, npos,
+        npos, npos
+    };
+
+    EXPECT_EQ(expected, handler.indices);
+    EXPECT_EQ("port", handler.names[8]);
+}
+
+
+TEST(KeySchema, NestedArrays) {
+    std::string document = "matrix = [[{ value = 1 }], [{ value = 2 }, { other = 3 }]]\nmatrix_value = 4";
+
+    schema_keys_handler_t handler;
+    loltoml::parse(document.data(), document.data() + document.size(), handler, with_schema(config_schema()));
+
+    EXPECT_EQ((std::vector<std::uint32_t>{npos, 7, 7, npos, npos}), handler.indices);
+}
+
+
+TEST(KeySchema, Stream) {
+    std::istringstream input("[server]\nhost = 'h'\nport = 80");
+    schema_keys_handler_t handler;
+    loltoml::parse(input, handler, with_schema(config_schema()));
+
+    EXPECT_EQ((std::vector<std::uint32_t>{1, 2}), handler.indices);
+}
+
+
+TEST(KeySchema, Dispatch) {
+    std::string document =
+        "[server]\n"
+        "host = 'example.org'\n"
+        "port = 8080\n"
+        "limits = { port = 1, host = 'skipped' }\n"
+        "[[servers]]\n"
+        "host = 'a'\n"
+        "[[servers]]\n"
+        "host = 'b'\n";
+
+    config_handler_t handler;
+    loltoml::parse(document.data(), document.data() + document.size(), handler, with_schema(config_schema()));
+
+    EXPECT_EQ("example.org", handler.host);
+    EXPECT_EQ(8080, handler.port);
+    EXPECT_EQ((std::vector<std::string>{"a", "b"}), handler.servers);
+    EXPECT_EQ(1u, handler.unknown);
+}
+
+
+TEST(KeySchema, HandlersWithoutSchemaKeys) {
+    std::string document = "title = 'x'\n[server]\nport = 1";
+    events_aggregator_t handler;
+    loltoml::parse(document.data(), document.data() + document.size(), handler, with_schema(config_schema()));
+
+    std::vector<sax_event_t> expected = {
+        {sax_event_t::start_document},
+        {sax_event_t::key, "title"},
+        {sax_event_t::string, "x"},
+        {sax_event_t::table, {"server"}},
+        {sax_event_t::key, "port"},
+        {sax_event_t::integer, 1},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected, handler.events);
+}
+
+
+TEST(KeySchema, WithOtherOptions) {
+    std::string document = "[server]\nhost = 'a'\nhost = 'b'";
+    loltoml::parse_options_t options = with_schema(config_schema());
+    options.check_duplicate_keys = true;
+
+    schema_keys_handler_t handler;
+    EXPECT_THROW(loltoml::parse(document.data(), document.data() + document.size(), handler, options), loltoml::parser_error_t);
+    EXPECT_EQ((std::vector<std::uint32_t>{1}), handler.indices);
+}
@@ -0,0 +1,125 @@
+#include "common.hpp"
+
+#include "loltoml/parse_file.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <unistd.h>
+
+
+namespace {
+    class temporary_file_t {
+    public:
+        explicit temporary_file_t(const std::string &content) {
+            char path[] = "/tmp/loltoml-test-XXXXXX";
+            int fd = mkstemp(path);
+            assert(fd != -1);
+            close(fd);
+
+            m_path = path;
+            std::ofstream output(m_path.c_str(), std::ios::binary);
+            output << content;
+        }
+
+        ~temporary_file_t() {
+            std::remove(m_path.c_str());
+        }
+
+        const char *path() const {
+            return m_path.c_str();
+        }
+
+    private:
+        std::string m_path;
+    };
+}
+
+
+TEST(ParseFile, Simple) {
+    temporary_file_t file("[table]\nkey = \"value\"\n");
+    events_aggregator_t handler;
+
+    loltoml::parse_file(file.path(), handler);
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::table, {"table"}},
+        {sax_event_t::key, "key"},
+        {sax_event_t::string, "value"},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, handler.events);
+}
+
+TEST(ParseFile, EmptyFile) {
+    temporary_file_t file("");
+    events_aggregator_t handler;
+
+    loltoml::parse_file(file.path(), handler);
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, handler.events);
+}
+
+TEST(ParseFile, ErrorOffsetIsRelativeToFileStart) {
+    std::string document = "a = 1\nb = \"\\q\"\n";
+    temporary_file_t file(document);
+
+    std::istringstream input(document);
+    events_aggregator_t stream_handler;
+    std::size_t expected_offset = 0;
+
+    try {
+        loltoml::parse(input, stream_handler);
+        FAIL();
+    } catch (const loltoml::parser_error_t &e) {
+        expected_offset = e.offset();
+    }
+
+    events_aggregator_t handler;
+
+    try {
+        loltoml::parse_file(file.path(), handler);
+        FAIL();
+    } catch (const loltoml::parser_error_t &e) {
+        EXPECT_EQ(expected_offset, e.offset());
+    }
+}
+
+TEST(ParseFile, MissingFile) {
+    events_aggregator_t handler;
+
+    EXPECT_THROW(loltoml::parse_file("/nonexistent/loltoml/file.toml", handler), loltoml::file_error_t);
+}
+
+TEST(ParseFile, Directory) {
+    events_aggregator_t handler;
+
+    EXPECT_THROW(loltoml::parse_file("/tmp", handler), loltoml::file_error_t);
+}
+
+TEST(ParseFile, Pipe) {
+    std::string document = "a = 1\n[b]\nc = 'd'\n";
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    ASSERT_EQ(static_cast<ssize_t>(document.size()), write(fds[1], document.data(), document.size()));
+    close(fds[1]);
+
+    // Pipes report the size 0, they must not be parsed as empty documents.
+    std::string path = "/dev/fd/" + std::to_string(fds[0]);
+    events_aggregator_t handler;
+    loltoml::parse_file(path.c_str(), handler);
+    close(fds[0]);
+
+    events_aggregator_t expected;
+    loltoml::parse(document.data(), document.data() + document.size(), expected);
+
+    EXPECT_EQ(expected.events, handler.events);
+}
@@ -0,0 +1,206 @@
+#include "common.hpp"
+
+#include "loltoml/reader.hpp"
+
+
+namespace {
+    sax_event_t to_sax_event(const loltoml::event_t &event) {
+        switch (event.type) {
+            case loltoml::event_type_t::comment:
+                return sax_event_t(sax_event_t::comment, std::string(event.text));
+            case loltoml::event_type_t::table:
+            case loltoml::event_type_t::array_table: {
+                std::vector<std::string> keys;
+
+                for (const loltoml::string_ref_t *key = event.path_begin; key != event.path_end; ++key) {
+                    keys.push_back(std::string(*key));
+                }
+
+                return sax_event_t(
+                    event.type == loltoml::event_type_t::table ? sax_event_t::table : sax_event_t::table_array_item,
+                    keys
+                );
+            }
+            case loltoml::event_type_t::key:
+                return sax_event_t(sax_event_t::key, std::string(event.text));
+            case loltoml::event_type_t::start_array:
+                return sax_event_t(sax_event_t::start_array);
+            case loltoml::event_type_t::finish_array:
+                return sax_event_t(sax_event_t::finish_array, event.size);
+            case loltoml::event_type_t::start_inline_table:
+                return sax_event_t(sax_event_t::start_inline_table);
+            case loltoml::event_type_t::finish_inline_table:
+                return sax_event_t(sax_event_t::finish_inline_table, event.size);
+            case loltoml::event_type_t::boolean:
+                return sax_event_t(sax_event_t::boolean, event.boolean);
+            case loltoml::event_type_t::string:
+                return sax_event_t(sax_event_t::string, std::string(event.text));
+            case loltoml::event_type_t::datetime:
+                return sax_event_t(sax_event_t::datetime, std::string(event.text));
+            case loltoml::event_type_t::integer:
+                return sax_event_t(sax_event_t::integer, event.integer);
+            case loltoml::event_type_t::floating_point:
+                return sax_event_t(sax_event_t::floating_point, event.floating_point);
+            case loltoml::event_type_t::symbol:
+                return sax_event_t(sax_event_t::symbol, std::string(event.text));
+        }
+
+        return sax_event_t();
+    }
+
+    std::vector<sax_event_t> read_all(const std::string &document, const loltoml::parse_options_t &options = loltoml::parse_options_t()) {
+        loltoml::reader_t reader(document.data(), document.data() + document.size(), options);
+        std::vector<sax_event_t> events;
+
+        while (reader.next()) {
+            events.push_back(to_sax_event(reader.event()));
+        }
+
+        return events;
+    }
+
+    std::vector<sax_event_t> parse_without_document_events(const std::string &document) {
+        events_aggregator_t handler;
+        loltoml::parse(document.data(), document.data() + document.size(), handler);
+
+        return std::vector<sax_event_t>(handler.events.begin() + 1, handler.events.end() - 1);
+    }
+
+    const std::string document =
+        "# comment\n"
+        "key = \"value\\t\\u00e9\"\n"
+        "\"\\t\" = 'escaped key'\n"
+        "\n\n"
+        "[table . \"quoted \\\" key\"]\r\n"
+        "multiline = \"\"\"\none\\\n   two\\n\"\"\"\n"
+        "[[array.table]] # trailing comment\n"
+        "inline = { x = 1, y = 1.5e3, z = [[true, false], [[]]] }\n"
+        "[[\"array\" . \"ta\\u0062le\"]]\n"
+        "empty = ''\n"
+        "symbol = key";
+}
+
+
+TEST(Reader, SameEventsAsParse) {
+    EXPECT_EQ(parse_without_document_events(document), read_all(document));
+}
+
+TEST(Reader, EmptyDocument) {
+    EXPECT_TRUE(read_all("").empty());
+    EXPECT_TRUE(read_all("\n\n   \n").empty());
+}
+
+TEST(Reader, EventsAreReadLazily) {
+    std::string invalid = "a = 1\nb = [2, 3]\nc = ?\n";
+    loltoml::reader_t reader(invalid.data(), invalid.data() + invalid.size());
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(sax_event_t(sax_event_t::key, "a"), to_sax_event(reader.event()));
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(sax_event_t(sax_event_t::integer, 1), to_sax_event(reader.event()));
+
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(reader.next());
+    }
+
+    EXPECT_EQ(sax_event_t(sax_event_t::finish_array, 2), to_sax_event(reader.event()));
+    EXPECT_THROW(reader.next(), loltoml::parser_error_t);
+}
+
+TEST(Reader, StringsReferToDocument) {
+    std::string text = "key = 'value'\n";
+    loltoml::reader_t reader(text.data(), text.data() + text.size());
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(text.data(), reader.event().text.data());
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(text.data() + 7, reader.event().text.data());
+}
+
+TEST(Reader, Skip) {
+    std::string text =
+        "skipped = [[1], [{ a = [] }, { b = [[2]] }], []]\n"
+        "table = { x = { y = 1 } }\n"
+        "scalar = 4\n"
+        "last = 5\n";
+
+    loltoml::reader_t reader(text.data(), text.data() + text.size());
+
+    ASSERT_TRUE(reader.next());
+    reader.skip();
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(sax_event_t(sax_event_t::key, "table"), to_sax_event(reader.event()));
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(sax_event_t(sax_event_t::start_inline_table), to_sax_event(reader.event()));
+    reader.skip();
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(sax_event_t(sax_event_t::key, "scalar"), to_sax_event(reader.event()));
+
+    reader.skip();
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(sax_event_t(sax_event_t::key, "last"), to_sax_event(reader.event()));
+}
+
+TEST(Reader, ErrorOffsets) {
+    std::string text = "a = 1\nb = \"\\q\"\n";
+    loltoml::reader_t reader(text.data(), text.data() + text.size());
+
+    try {
+        while (reader.next()) { }
+        ADD_FAILURE() << "Document parsed successfully";
+    } catch (const loltoml::parser_error_t &e) {
+        EXPECT_EQ(11u, e.offset());
+    }
+}
+
+TEST(Reader, ValidatesUtf8) {
+    std::string text = "a = '\xff'\n";
+    loltoml::parse_options_t options;
+    options.validate_utf8 = true;
+
+    EXPECT_THROW(loltoml::reader_t(text.data(), text.data() + text.size(), options), loltoml::parser_error_t);
+}
+
+TEST(Reader, StopsAfterKeys) {
+    std::string text = "a = 1\nb = 2\nc = 3\n";
+    loltoml::parse_options_t options;
+    options.stop_after_keys = {{"a"}};
+
+    std::vector<sax_event_t> expected = {
+        {sax_event_t::key, "a"},
+        {sax_event_t::integer, 1}
+    };
+
+    EXPECT_EQ(expected, read_all(text, options));
+
+    options.stop_after_keys = {{"b"}, {"t", "c"}};
+    EXPECT_EQ(parse_without_document_events(text), read_all(text, options));
+}
+
+TEST(Reader, ChecksDuplicateKeys) {
+    std::string text = "a = 1\na = 2\n";
+    loltoml::parse_options_t options;
+    options.check_duplicate_keys = true;
+
+    loltoml::reader_t reader(text.data(), text.data() + text.size(), options);
+    std::vector<sax_event_t> events;
+
+    try {
+        while (reader.next()) {
+            events.push_back(to_sax_event(reader.event()));
+        }
+
+        ADD_FAILURE() << "Document parsed successfully";
+    } catch (const loltoml::parser_error_t &e) {
+        EXPECT_EQ(6u, e.offset());
+    }
+
+    std::vector<sax_event_t> expected = {
+        {sax_event_t::key, "a"},
+        {sax_event_t::integer, 1}
+    };
+
+    EXPECT_EQ(expected, events);
+    EXPECT_EQ(parse_without_document_events(text), read_all(text));
+}
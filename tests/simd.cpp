@@ -0,0 +1,140 @@
+#include "common.hpp"
+
+#include "loltoml/detail/simd.hpp"
+
+#include <sstream>
+
+
+namespace {
+    template<class Class>
+    const char *reference_skip(const char *begin, const char *end) {
+        while (begin != end && Class::contains(*begin)) {
+            ++begin;
+        }
+
+        return begin;
+    }
+
+    // Places a stop character at every position of runs of various lengths and checks the kernel finds it.
+    template<class Class>
+    void test_kernel(char filler, const std::string &stops) {
+        for (std::size_t length = 0; length < 100; ++length) {
+            for (std::size_t position = 0; position <= length; ++position) {
+                for (std::size_t i = 0; i < stops.size(); ++i) {
+                    std::string data(length, filler);
+
+                    if (position < length) {
+                        data[position] = stops[i];
+                    }
+
+                    const char *begin = data.data();
+                    const char *end = data.data() + data.size();
+
+                    ASSERT_EQ(reference_skip<Class>(begin, end) - begin,
+                              loltoml::detail::simd::skip<Class>(begin, end) - begin)
+                        << "length " << length << ", position " << position << ", stop " << int(stops[i]);
+                }
+            }
+        }
+    }
+}
+
+
+TEST(Simd, SkipBlanks) {
+    test_kernel<loltoml::detail::simd::blank_class_t>(' ', std::string("x\n\r#\0\x80", 6));
+    test_kernel<loltoml::detail::simd::blank_class_t>('\t', std::string("x\n\r#\0\x80", 6));
+}
+
+TEST(Simd, SkipWhitespace) {
+    test_kernel<loltoml::detail::simd::whitespace_class_t>('\n', std::string("x\r#\0\x80", 5));
+    test_kernel<loltoml::detail::simd::whitespace_class_t>(' ', std::string("x\r#\0\x80", 5));
+}
+
+TEST(Simd, SkipComment) {
+    test_kernel<loltoml::detail::simd::comment_class_t>('a', std::string("\n\r\b\0\x1f", 5));
+    test_kernel<loltoml::detail::simd::comment_class_t>('\xd0', std::string("\n\r\b\0\x1f", 5));
+    test_kernel<loltoml::detail::simd::comment_class_t>('\t', std::string("\n\r\b\0\x1f", 5));
+}
+
+TEST(Simd, SkipBasicString) {
+    test_kernel<loltoml::detail::simd::basic_string_class_t>('a', std::string("\"\\\n\t\0\x1f", 6));
+    test_kernel<loltoml::detail::simd::basic_string_class_t>('\xe2', std::string("\"\\\n\t\0\x1f", 6));
+}
+
+TEST(Simd, SkipLiteralString) {
+    test_kernel<loltoml::detail::simd::literal_string_class_t>('a', std::string("'\n\r\0\x1f", 5));
+    test_kernel<loltoml::detail::simd::literal_string_class_t>('\t', std::string("'\n\r\0\x1f", 5));
+}
+
+TEST(Simd, SkipUnstructured) {
+    test_kernel<loltoml::detail::simd::unstructured_class_t>('a', std::string("\"'[]{}#\r\n", 9));
+    test_kernel<loltoml::detail::simd::unstructured_class_t>(',', std::string("\"'[]{}#\r\n", 9));
+    test_kernel<loltoml::detail::simd::unstructured_class_t>('\0', std::string("\"'[]{}#\r\n", 9));
+}
+
+TEST(Simd, LongStrings) {
+    std::string body(300, 'x');
+    std::string document =
+        "basic = \"" + body + "\\t" + body + "\\u00e9" + body + "\"\n"
+        "literal = '" + body + "\\" + body + "'\n"
+        "multiline = \"\"\"\n" + body + "\n" + body + "\"\"" + body + "\\\n  " + body + "\"\"\"\n"
+        "multiline_literal = '''" + body + "\r\n" + body + "''" + body + "'''\n";
+
+    std::istringstream input(document);
+    events_aggregator_t stream_handler;
+    loltoml::parse(input, stream_handler);
+
+    events_aggregator_t buffer_handler;
+    loltoml::parse(document.data(), document.data() + document.size(), buffer_handler);
+
+    EXPECT_EQ(stream_handler.events, buffer_handler.events);
+    EXPECT_EQ(sax_event_t(sax_event_t::string, body + "\t" + body + "\xc3\xa9" + body), buffer_handler.events[2]);
+    EXPECT_EQ(sax_event_t(sax_event_t::string, body + "\\" + body), buffer_handler.events[4]);
+    EXPECT_EQ(sax_event_t(sax_event_t::string, body + "\n" + body + "\"\"" + body + body), buffer_handler.events[6]);
+    EXPECT_EQ(sax_event_t(sax_event_t::string, body + "\n" + body + "''" + body), buffer_handler.events[8]);
+}
+
+TEST(Simd, ControlCharacterInLongString) {
+    std::string document = "key = \"" + std::string(70, 'c') + "\x01\"";
+
+    events_aggregator_t handler;
+
+    try {
+        loltoml::parse(document.data(), document.data() + document.size(), handler);
+        FAIL();
+    } catch (const loltoml::parser_error_t &e) {
+        EXPECT_EQ(77, e.offset());
+    }
+}
+
+TEST(Simd, LongCommentsAndIndentation) {
+    std::string comment(1000, 'c');
+    std::string indentation(77, ' ');
+    std::string document =
+        indentation + "#" + comment + "\n" +
+        "\t\t" + indentation + "key = [" + indentation + "\n" + indentation + "1, # " + comment + "\r\n" +
+        indentation + "2" + indentation + "]" + indentation + "#" + comment;
+
+    std::istringstream input(document);
+    events_aggregator_t stream_handler;
+    loltoml::parse(input, stream_handler);
+
+    events_aggregator_t buffer_handler;
+    loltoml::parse(document.data(), document.data() + document.size(), buffer_handler);
+
+    EXPECT_EQ(stream_handler.events, buffer_handler.events);
+    EXPECT_EQ(sax_event_t(sax_event_t::comment, comment), buffer_handler.events[1]);
+}
+
+TEST(Simd, ControlCharacterInLongComment) {
+    std::string document = "#" + std::string(70, 'c') + "\b";
+
+    events_aggregator_t handler;
+
+    try {
+        loltoml::parse(document.data(), document.data() + document.size(), handler);
+        FAIL();
+    } catch (const loltoml::parser_error_t &e) {
+        EXPECT_EQ(71, e.offset());
+    }
+}
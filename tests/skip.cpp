@@ -0,0 +1,195 @@
+#include "common.hpp"
+
+#include "loltoml/incremental_parser.hpp"
+
+#include <set>
+#include <sstream>
+
+
+namespace {
+    // Records events like events_aggregator_t, but asks to skip the given keys and tables.
+    struct skipping_handler_t : events_aggregator_t {
+        std::set<std::string> skipped_keys;
+        std::set<std::string> skipped_tables;
+
+        loltoml::action_t key(const std::string &key) {
+            events_aggregator_t::key(key);
+            return skipped_keys.count(key) ? loltoml::action_t::skip : loltoml::action_t::proceed;
+        }
+
+        loltoml::action_t table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
+            events_aggregator_t::table(begin, end);
+            return skipped_tables.count(*begin) ? loltoml::action_t::skip : loltoml::action_t::proceed;
+        }
+
+        loltoml::action_t array_table(loltoml::key_iterator_t begin, loltoml::key_iterator_t end) {
+            events_aggregator_t::array_table(begin, end);
+            return skipped_tables.count(*begin) ? loltoml::action_t::skip : loltoml::action_t::proceed;
+        }
+    };
+
+    std::vector<sax_event_t> parse_buffer(const std::string &document, skipping_handler_t handler) {
+        loltoml::parse(document.data(), document.data() + document.size(), handler);
+        return handler.events;
+    }
+
+    std::vector<sax_event_t> parse_stream(const std::string &document, skipping_handler_t handler) {
+        std::istringstream input(document);
+        loltoml::parse(input, handler);
+        return handler.events;
+    }
+
+    // Feeds the document to the incremental parser in pieces of the given size.
+    std::vector<sax_event_t> parse_pieces(const std::string &document, std::size_t piece_size, skipping_handler_t handler) {
+        loltoml::incremental_parser_t<skipping_handler_t> parser(handler);
+
+        for (std::size_t position = 0; position < document.size(); position += piece_size) {
+            parser.feed(document.data() + position, std::min(piece_size, document.size() - position));
+        }
+
+        parser.finish();
+        return handler.events;
+    }
+}
+
+
+TEST(Skip, Values) {
+    std::string document =
+        "a = 1\n"
+        "b = \"string with ] and # and \\\" inside\" # comment\n"
+        "c = 'literal \\'\n"
+        "d = \"\"\"\nmulti\n\"\" line \\\"\"\" \"\"\"\n"
+        "e = '''\nmulti ' '' line\n'''\n"
+        "f = [\n  [1, 2], # comment with ] and \"\n  [\"]\", '['],\n]\n"
+        "g = { x = [1], y = { z = \"}\" } }\n"
+        "h = 1979-05-27T07:32:00Z\n"
+        "i = 2\n";
+
+    skipping_handler_t handler;
+    handler.skipped_keys = {"b", "c", "d", "e", "f", "g", "h"};
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::key, "a"},
+        {sax_event_t::integer, 1},
+        {sax_event_t::key, "b"},
+        {sax_event_t::comment, " comment"},
+        {sax_event_t::key, "c"},
+        {sax_event_t::key, "d"},
+        {sax_event_t::key, "e"},
+        {sax_event_t::key, "f"},
+        {sax_event_t::key, "g"},
+        {sax_event_t::key, "h"},
+        {sax_event_t::key, "i"},
+        {sax_event_t::integer, 2},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, parse_buffer(document, handler));
+    EXPECT_EQ(expected_events, parse_stream(document, handler));
+}
+
+TEST(Skip, InlineTableValues) {
+    std::string document = "a = { b = [1, 2], c = 3, d = { e = 4 }, f = 5 }\n";
+
+    skipping_handler_t handler;
+    handler.skipped_keys = {"b", "d"};
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::key, "a"},
+        {sax_event_t::start_inline_table},
+        {sax_event_t::key, "b"},
+        {sax_event_t::key, "c"},
+        {sax_event_t::integer, 3},
+        {sax_event_t::key, "d"},
+        {sax_event_t::key, "f"},
+        {sax_event_t::integer, 5},
+        {sax_event_t::finish_inline_table, 4},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, parse_buffer(document, handler));
+    EXPECT_EQ(expected_events, parse_stream(document, handler));
+}
+
+TEST(Skip, Sections) {
+    std::string document =
+        "a = 1\n"
+        "[skipped] # comment\n"
+        "b = 2\n"
+        "# comment\n"
+        "\n"
+        "c = [\n  \"\"\"\n[not.a.table]\n\"\"\",\n]\n"
+        "[[skipped.array]]\n"
+        "d = 3\n"
+        "[kept]\n"
+        "e = 4\n"
+        "[[skipped]]\n"
+        "f = 5\n"
+        "[[kept]]\n"
+        "g = 6";
+
+    skipping_handler_t handler;
+    handler.skipped_tables = {"skipped"};
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::key, "a"},
+        {sax_event_t::integer, 1},
+        {sax_event_t::table, {"skipped"}},
+        {sax_event_t::comment, " comment"},
+        {sax_event_t::table_array_item, {"skipped", "array"}},
+        {sax_event_t::table, {"kept"}},
+        {sax_event_t::key, "e"},
+        {sax_event_t::integer, 4},
+        {sax_event_t::table_array_item, {"skipped"}},
+        {sax_event_t::table_array_item, {"kept"}},
+        {sax_event_t::key, "g"},
+        {sax_event_t::integer, 6},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, parse_buffer(document, handler));
+    EXPECT_EQ(expected_events, parse_stream(document, handler));
+
+    for (std::size_t piece_size = 1; piece_size <= document.size(); ++piece_size) {
+        ASSERT_EQ(expected_events, parse_pieces(document, piece_size, handler)) << "piece size " << piece_size;
+    }
+}
+
+TEST(Skip, SectionsInPieces) {
+    std::string document = "[skip]\na = 1\nb = 2\n[keep]\nc = 3\n";
+
+    skipping_handler_t handler;
+    handler.skipped_tables = {"skip"};
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::table, {"skip"}},
+        {sax_event_t::table, {"keep"}},
+        {sax_event_t::key, "c"},
+        {sax_event_t::integer, 3},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, parse_buffer(document, handler));
+    EXPECT_EQ(expected_events, parse_pieces(document, 1, handler));
+}
+
+TEST(Skip, UnterminatedString) {
+    skipping_handler_t handler;
+    handler.skipped_keys = {"a"};
+
+    EXPECT_THROW(parse_buffer("a = \"abc\nb = 1\n", handler), loltoml::parser_error_t);
+    EXPECT_THROW(parse_buffer("a = [\"\"\"abc]\n", handler), loltoml::parser_error_t);
+    EXPECT_THROW(parse_stream("a = ['abc", handler), loltoml::parser_error_t);
+}
+
+TEST(Skip, UnterminatedArray) {
+    skipping_handler_t handler;
+    handler.skipped_keys = {"a"};
+
+    EXPECT_THROW(parse_buffer("a = [1, 2\n", handler), loltoml::parser_error_t);
+    EXPECT_THROW(parse_stream("a = [1, 2\n", handler), loltoml::parser_error_t);
+}
@@ -0,0 +1,243 @@
+#include "common.hpp"
+
+#include "loltoml/incremental_parser.hpp"
+#include "loltoml/reader.hpp"
+
+#include <sstream>
+
+
+namespace {
+    // Records events and stops at the given integer.
+    struct stopping_handler_t : events_aggregator_t {
+        std::int64_t stop_at;
+
+        explicit stopping_handler_t(std::int64_t stop_at) :
+            stop_at(stop_at)
+        { }
+
+        loltoml::action_t integer(std::int64_t value) {
+            events_aggregator_t::integer(value);
+            return value == stop_at ? loltoml::action_t::stop : loltoml::action_t::proceed;
+        }
+    };
+
+    // The tail is invalid, so the parser fails if it reads it.
+    const std::string document =
+        "title = 'config'\n"
+        "[server]\n"
+        "host = \"localhost\"\n"
+        "port = 8080\n"
+        "limits = { connections = 10, timeout = 2.5 }\n"
+        "[[backends]]\n"
+        "weights = [1, 2]\n"
+        "[[backends]]\n"
+        "weights = [3]\n"
+        "invalid tail\n";
+}
+
+
+TEST(Stop, FromHandler) {
+    std::istringstream input(document);
+    stopping_handler_t handler(8080);
+    loltoml::parse(input, handler);
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::key, "title"},
+        {sax_event_t::string, "config"},
+        {sax_event_t::table, {"server"}},
+        {sax_event_t::key, "host"},
+        {sax_event_t::string, "localhost"},
+        {sax_event_t::key, "port"},
+        {sax_event_t::integer, 8080},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, handler.events);
+
+    // The rest of the stream isn't read.
+    std::string rest((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(document.substr(document.find("8080") + 4), rest);
+}
+
+TEST(Stop, AfterKeys) {
+    loltoml::parse_options_t options;
+    options.stop_after_keys = {{"title"}, {"server", "limits", "timeout"}, {"server", "port"}};
+
+    std::istringstream input(document);
+    events_aggregator_t handler;
+    loltoml::parse(input, handler, options);
+
+    ASSERT_LE(3u, handler.events.size());
+    EXPECT_EQ(sax_event_t(sax_event_t::floating_point, 2.5), handler.events[handler.events.size() - 3]);
+    EXPECT_EQ(sax_event_t(sax_event_t::finish_inline_table, 2), handler.events[handler.events.size() - 2]);
+    EXPECT_EQ(sax_event_t(sax_event_t::finish_document), handler.events.back());
+
+    events_aggregator_t buffer_handler;
+    loltoml::parse(document.data(), document.data() + document.size(), buffer_handler, options);
+    EXPECT_EQ(handler.events, buffer_handler.events);
+}
+
+TEST(Stop, AfterKeysOfArrays) {
+    loltoml::parse_options_t options;
+    options.stop_after_keys = {{"backends", "weights"}};
+
+    events_aggregator_t handler;
+    loltoml::parse(document.data(), document.data() + document.size(), handler, options);
+
+    std::vector<sax_event_t> expected_tail = {
+        {sax_event_t::table_array_item, {"backends"}},
+        {sax_event_t::key, "weights"},
+        {sax_event_t::start_array},
+        {sax_event_t::integer, 1},
+        {sax_event_t::integer, 2},
+        {sax_event_t::finish_array, 2},
+        {sax_event_t::finish_document}
+    };
+
+    ASSERT_LE(expected_tail.size(), handler.events.size());
+    EXPECT_EQ(expected_tail, std::vector<sax_event_t>(handler.events.end() - expected_tail.size(), handler.events.end()));
+}
+
+TEST(Stop, InsideInlineTable) {
+    std::string text = "owner = { name = 'x', y = 1 }\ninvalid tail\n";
+    loltoml::parse_options_t options;
+    options.stop_after_keys = {{"owner", "name"}};
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::key, "owner"},
+        {sax_event_t::start_inline_table},
+        {sax_event_t::key, "name"},
+        {sax_event_t::string, "x"},
+        {sax_event_t::finish_inline_table, 1},
+        {sax_event_t::finish_document}
+    };
+
+    events_aggregator_t handler;
+    loltoml::parse(text.data(), text.data() + text.size(), handler, options);
+    EXPECT_EQ(expected_events, handler.events);
+
+    std::istringstream input(text);
+    events_aggregator_t stream_handler;
+    loltoml::parse(input, stream_handler, options);
+    EXPECT_EQ(expected_events, stream_handler.events);
+
+    // The reader ends the document the same way, without start_document and finish_document.
+    loltoml::reader_t reader(text.data(), text.data() + text.size(), options);
+    std::vector<loltoml::event_type_t> types;
+
+    while (reader.next()) {
+        types.push_back(reader.event().type);
+    }
+
+    std::vector<loltoml::event_type_t> expected_types = {
+        loltoml::event_type_t::key,
+        loltoml::event_type_t::start_inline_table,
+        loltoml::event_type_t::key,
+        loltoml::event_type_t::string,
+        loltoml::event_type_t::finish_inline_table
+    };
+
+    EXPECT_EQ(expected_types, types);
+}
+
+TEST(Stop, InsideArrayOfInlineTables) {
+    std::string text = "servers = [{ host = 'a', port = 1 }, { host = 'b', port = 2 }, { host = 'c' }]\ninvalid tail\n";
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::key, "servers"},
+        {sax_event_t::start_array},
+        {sax_event_t::start_inline_table},
+        {sax_event_t::key, "host"},
+        {sax_event_t::string, "a"},
+        {sax_event_t::key, "port"},
+        {sax_event_t::integer, 1},
+        {sax_event_t::finish_inline_table, 2},
+        {sax_event_t::start_inline_table},
+        {sax_event_t::key, "host"},
+        {sax_event_t::string, "b"},
+        {sax_event_t::key, "port"},
+        {sax_event_t::integer, 2},
+        {sax_event_t::finish_inline_table, 2},
+        {sax_event_t::finish_array, 2},
+        {sax_event_t::finish_document}
+    };
+
+    stopping_handler_t handler(2);
+    loltoml::parse(text.data(), text.data() + text.size(), handler);
+    EXPECT_EQ(expected_events, handler.events);
+
+    stopping_handler_t incremental_handler(2);
+    loltoml::incremental_parser_t<stopping_handler_t> parser(incremental_handler);
+    parser.feed(text.data(), text.size());
+    parser.finish();
+    EXPECT_EQ(expected_events, incremental_handler.events);
+
+    // Keys inside arrays stop at their first occurrence.
+    loltoml::parse_options_t options;
+    options.stop_after_keys = {{"servers", "host"}};
+
+    events_aggregator_t keys_handler;
+    loltoml::parse(text.data(), text.data() + text.size(), keys_handler, options);
+
+    std::vector<sax_event_t> expected_tail = {
+        {sax_event_t::string, "a"},
+        {sax_event_t::finish_inline_table, 1},
+        {sax_event_t::finish_array, 1},
+        {sax_event_t::finish_document}
+    };
+
+    ASSERT_LE(expected_tail.size(), keys_handler.events.size());
+    EXPECT_EQ(expected_tail, std::vector<sax_event_t>(keys_handler.events.end() - expected_tail.size(), keys_handler.events.end()));
+}
+
+TEST(Stop, MissingKeysReadWholeDocument) {
+    loltoml::parse_options_t options;
+    options.stop_after_keys = {{"title"}, {"server", "missing"}};
+
+    events_aggregator_t handler;
+    EXPECT_THROW(
+        loltoml::parse(document.data(), document.data() + document.size(), handler, options),
+        loltoml::parser_error_t
+    );
+}
+
+TEST(Stop, SkippedKeysAreDelivered) {
+    struct skipping_handler_t : events_aggregator_t {
+        loltoml::action_t key(const std::string &key) {
+            events_aggregator_t::key(key);
+            return key == "limits" ? loltoml::action_t::skip : loltoml::action_t::proceed;
+        }
+    };
+
+    loltoml::parse_options_t options;
+    options.stop_after_keys = {{"server", "limits"}};
+
+    skipping_handler_t handler;
+    loltoml::parse(document.data(), document.data() + document.size(), handler, options);
+
+    ASSERT_LE(2u, handler.events.size());
+    EXPECT_EQ(sax_event_t(sax_event_t::key, "limits"), handler.events[handler.events.size() - 2]);
+}
+
+TEST(Stop, Incremental) {
+    stopping_handler_t handler(8080);
+    loltoml::incremental_parser_t<stopping_handler_t> parser(handler);
+
+    std::size_t fed = 0;
+
+    while (fed < document.size() && !parser.stopped()) {
+        std::size_t piece = std::min<std::size_t>(7, document.size() - fed);
+        parser.feed(document.data() + fed, piece);
+        fed += piece;
+    }
+
+    EXPECT_TRUE(parser.stopped());
+    EXPECT_LT(fed, document.find("invalid"));
+
+    parser.finish();
+    EXPECT_EQ(sax_event_t(sax_event_t::integer, 8080), handler.events[handler.events.size() - 2]);
+    EXPECT_EQ(sax_event_t(sax_event_t::finish_document), handler.events.back());
+}
@@ -0,0 +1,131 @@
+#include "common.hpp"
+
+#include <sstream>
+
+
+namespace {
+    // Records string events and remembers whether they referred to the source buffer.
+    struct zero_copy_handler_t :
+        public events_aggregator_t
+    {
+        typedef loltoml::string_ref_t string_type;
+
+        const char *begin;
+        const char *end;
+        std::vector<bool> in_source;
+
+        zero_copy_handler_t(const std::string &document) :
+            begin(document.data()),
+            end(document.data() + document.size())
+        { }
+
+        void record(sax_event_t::type_t type, loltoml::string_ref_t value) {
+            events.emplace_back(type, value.str());
+            in_source.push_back(value.data() >= begin && value.data() + value.size() <= end);
+        }
+
+        void comment(loltoml::string_ref_t value) {
+            record(sax_event_t::comment, value);
+        }
+
+        void key(loltoml::string_ref_t value) {
+            record(sax_event_t::key, value);
+        }
+
+        void string(loltoml::string_ref_t value) {
+            record(sax_event_t::string, value);
+        }
+
+        void symbol(loltoml::string_ref_t value) {
+            record(sax_event_t::symbol, value);
+        }
+    };
+}
+
+
+TEST(StringRef, Comparison) {
+    std::string value = "value";
+    loltoml::string_ref_t ref(value);
+
+    EXPECT_TRUE(ref == "value");
+    EXPECT_TRUE(ref == value);
+    EXPECT_TRUE(ref != "valu");
+    EXPECT_TRUE(ref < "values");
+    EXPECT_FALSE(ref < "value");
+    EXPECT_EQ("value", ref.str());
+    EXPECT_TRUE(loltoml::string_ref_t().empty());
+}
+
+TEST(StringRef, UnescapedTokensReferToBuffer) {
+    std::string document =
+        "# comment\n"
+        "key = \"value\"\n"
+        "\"quoted\" = 'literal'\n"
+        "symbol = key\n"
+        "multiline = \"\"\"\nsingle line \"quoted\" here\"\"\"\n";
+    zero_copy_handler_t handler(document);
+
+    loltoml::parse(document.data(), document.data() + document.size(), handler);
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::comment, " comment"},
+        {sax_event_t::key, "key"},
+        {sax_event_t::string, "value"},
+        {sax_event_t::key, "quoted"},
+        {sax_event_t::string, "literal"},
+        {sax_event_t::key, "symbol"},
+        {sax_event_t::symbol, "key"},
+        {sax_event_t::key, "multiline"},
+        {sax_event_t::string, "single line \"quoted\" here"},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, handler.events);
+    EXPECT_EQ(std::vector<bool>(9, true), handler.in_source);
+}
+
+TEST(StringRef, EscapedTokensAreMaterialized) {
+    std::string document =
+        "\"k\\tey\" = \"a\\u00e9b\"\n"
+        "multiline = \"\"\"\none \\\n   two\"\"\"\n"
+        "crlf = '''\r\nfirst\r\nsecond'''\n";
+    zero_copy_handler_t handler(document);
+
+    loltoml::parse(document.data(), document.data() + document.size(), handler);
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::key, "k\tey"},
+        {sax_event_t::string, "a\xc3\xa9" "b"},
+        {sax_event_t::key, "multiline"},
+        {sax_event_t::string, "one two"},
+        {sax_event_t::key, "crlf"},
+        {sax_event_t::string, "first\nsecond"},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, handler.events);
+
+    std::vector<bool> expected_in_source = {false, false, true, false, true, false};
+    EXPECT_EQ(expected_in_source, handler.in_source);
+}
+
+TEST(StringRef, StreamInput) {
+    std::string document = "key = \"value\" # comment";
+    std::istringstream input(document);
+    zero_copy_handler_t handler(document);
+
+    loltoml::parse(input, handler);
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::key, "key"},
+        {sax_event_t::string, "value"},
+        {sax_event_t::comment, " comment"},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, handler.events);
+    EXPECT_EQ(std::vector<bool>(3, false), handler.in_source);
+}
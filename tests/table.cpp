@@ -63,6 +63,24 @@ TEST(Table, MultipleKeys) {
     EXPECT_EQ(expected_events, handler.events);
 }
 
+TEST(Table, ShorterPathAfterLonger) {
+    std::istringstream input("[a.b.c]\n[[d]]\n[e.\"x y\"]\n[f.g]");
+    events_aggregator_t handler;
+
+    loltoml::parse(input, handler);
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::table, {"a", "b", "c"}},
+        {sax_event_t::table_array_item, {"d"}},
+        {sax_event_t::table, {"e", "x y"}},
+        {sax_event_t::table, {"f", "g"}},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, handler.events);
+}
+
 TEST(Table, TableCanBeWrappedWithSpacesAndComments) {
     std::istringstream input("\r\n   \n  \t    [table.123.\"table\\ntable\"]   # comment\r\n\n");
     events_aggregator_t handler;
@@ -0,0 +1,250 @@
+#include "common.hpp"
+
+#include "loltoml/tape_document.hpp"
+
+#include <sstream>
+
+
+namespace {
+    loltoml::tape_document_t parse_tape(const std::string &document, const loltoml::parse_options_t &options = loltoml::parse_options_t()) {
+        return loltoml::parse_tape(document.data(), document.data() + document.size(), options);
+    }
+
+    // Replays the tape as SAX-events, to compare it with the events of the parser.
+    std::vector<sax_event_t> replay(const loltoml::tape_document_t &document) {
+        std::vector<sax_event_t> events;
+        const std::size_t size = document.tape().size();
+
+        for (std::size_t index = 0; index < size;) {
+            switch (document.type(index)) {
+                case loltoml::tape_type_t::root:
+                    events.push_back({index == 0 ? sax_event_t::start_document : sax_event_t::finish_document});
+                    ++index;
+                    break;
+                case loltoml::tape_type_t::table:
+                case loltoml::tape_type_t::array_table: {
+                    std::vector<std::string> keys;
+
+                    for (std::size_t i = 0; i < document.path_size(index); ++i) {
+                        keys.push_back(document.string_at(index + 2 + i).str());
+                    }
+
+                    bool is_table = document.type(index) == loltoml::tape_type_t::table;
+                    events.push_back({is_table ? sax_event_t::table : sax_event_t::table_array_item, keys});
+                    index += 2 + keys.size();
+                    break;
+                }
+                case loltoml::tape_type_t::key:
+                    events.push_back({sax_event_t::key, document.string_at(index).str()});
+                    ++index;
+                    break;
+                case loltoml::tape_type_t::start_array:
+                    events.push_back({sax_event_t::start_array});
+                    ++index;
+                    break;
+                case loltoml::tape_type_t::finish_array:
+                    events.push_back({sax_event_t::finish_array, static_cast<std::int64_t>(document.payload(index))});
+                    ++index;
+                    break;
+                case loltoml::tape_type_t::start_inline_table:
+                    events.push_back({sax_event_t::start_inline_table});
+                    ++index;
+                    break;
+                case loltoml::tape_type_t::finish_inline_table:
+                    events.push_back({sax_event_t::finish_inline_table, static_cast<std::int64_t>(document.payload(index))});
+                    ++index;
+                    break;
+                case loltoml::tape_type_t::boolean:
+                    events.push_back({sax_event_t::boolean, document.boolean_at(index)});
+                    ++index;
+                    break;
+                case loltoml::tape_type_t::string:
+                    events.push_back({sax_event_t::string, document.string_at(index).str()});
+                    ++index;
+                    break;
+                case loltoml::tape_type_t::datetime:
+                    events.push_back({sax_event_t::datetime, document.string_at(index).str()});
+                    ++index;
+                    break;
+                case loltoml::tape_type_t::symbol:
+                    events.push_back({sax_event_t::symbol, document.string_at(index).str()});
+                    ++index;
+                    break;
+                case loltoml::tape_type_t::integer:
+                    events.push_back({sax_event_t::integer, document.integer_at(index)});
+                    index += 2;
+                    break;
+                case loltoml::tape_type_t::floating_point:
+                    events.push_back({sax_event_t::floating_point, document.floating_point_at(index)});
+                    index += 2;
+                    break;
+            }
+        }
+
+        return events;
+    }
+
+    const std::string document =
+        "title = 'config'\n"
+        "symbol = other\n"
+        "[server]\n"
+        "host = \"local\\nhost\"\n"
+        "ports = [8080, 8081]\n"
+        "limits = { connections = 10, timeout = 2.5, nested = { on = true } }\n"
+        "[[backends]]\n"
+        "weights = [[1, 2], [3]]\n"
+        "[[backends]]\n"
+        "[a.\"b c\"]\n"
+        "empty = []\n";
+}
+
+
+TEST(TapeDocument, Empty) {
+    loltoml::tape_document_t empty;
+    EXPECT_EQ(2u, empty.tape().size());
+    EXPECT_EQ(2u, empty.next(0));
+
+    loltoml::tape_document_t parsed = parse_tape("# comment\n");
+    EXPECT_EQ(empty.tape(), parsed.tape());
+    EXPECT_TRUE(parsed.strings().empty());
+}
+
+
+TEST(TapeDocument, MatchesEvents) {
+    events_aggregator_t handler;
+    loltoml::parse(document.data(), document.data() + document.size(), handler);
+
+    EXPECT_EQ(handler.events, replay(parse_tape(document)));
+}
+
+
+TEST(TapeDocument, Next) {
+    loltoml::tape_document_t tape = parse_tape(document);
+
+    // The first root word skips the whole document.
+    EXPECT_EQ(tape.tape().size(), tape.next(0));
+
+    // Headers skip their sections, so the top level is a list of sections.
+    std::vector<std::string> sections;
+
+    for (std::size_t index = 1; index + 1 < tape.tape().size(); index = tape.next(index)) {
+        if (tape.type(index) == loltoml::tape_type_t::table || tape.type(index) == loltoml::tape_type_t::array_table) {
+            sections.push_back(tape.string_at(index + 2).str());
+        } else {
+            // Top-level key-value pairs before the first header.
+            EXPECT_TRUE(sections.empty());
+        }
+    }
+
+    EXPECT_EQ((std::vector<std::string>{"server", "backends", "backends", "a"}), sections);
+
+    // Arrays and inline tables are skipped with their contents.
+    std::size_t index = 0;
+
+    while (tape.type(index) != loltoml::tape_type_t::start_inline_table) {
+        ++index;
+    }
+
+    std::size_t after = tape.next(index);
+    EXPECT_EQ(loltoml::tape_type_t::finish_inline_table, tape.type(after - 1));
+    EXPECT_EQ(3u, tape.payload(after - 1));
+    EXPECT_EQ(loltoml::tape_type_t::array_table, tape.type(after));
+}
+
+
+TEST(TapeDocument, WriteAndRead) {
+    loltoml::tape_document_t tape = parse_tape(document);
+
+    std::stringstream stream;
+    tape.write(stream);
+    loltoml::tape_document_t loaded = loltoml::tape_document_t::read(stream);
+
+    EXPECT_EQ(tape.tape(), loaded.tape());
+    EXPECT_EQ(tape.strings(), loaded.strings());
+
+    std::string truncated = stream.str().substr(0, stream.str().size() - 1);
+    std::istringstream input(truncated);
+    EXPECT_THROW(loltoml::tape_document_t::read(input), loltoml::stream_error_t);
+}
+
+
+TEST(TapeDocument, ReadRejectsMalformedTapes) {
+    loltoml::tape_document_t tape = parse_tape(document);
+
+    // Writes the buffers of the document with one word of the tape or one byte of the strings replaced.
+    auto corrupted = [&tape](std::size_t index, std::uint64_t word, std::size_t string_size) {
+        std::vector<std::uint64_t> words = tape.tape();
+
+        if (index < words.size()) {
+            words[index] = word;
+        }
+
+        std::stringstream stream;
+        loltoml::tape_document_t(words, tape.strings().substr(0, string_size)).write(stream);
+        return stream.str();
+    };
+
+    auto read = [](const std::string &snapshot) {
+        std::istringstream input(snapshot);
+        return loltoml::tape_document_t::read(input);
+    };
+
+    // The first entries of these types, as in the Next test.
+    auto find = [&tape](loltoml::tape_type_t type) {
+        std::size_t index = 0;
+
+        while (index < tape.tape().size() && tape.type(index) != type) {
+            ++index;
+        }
+
+        return index == tape.tape().size() ? 0 : index;
+    };
+
+    std::size_t inline_table = find(loltoml::tape_type_t::start_inline_table);
+    std::size_t header = find(loltoml::tape_type_t::table);
+    std::size_t string = find(loltoml::tape_type_t::key);
+
+    ASSERT_NE(0u, inline_table);
+    ASSERT_NE(0u, header);
+    ASSERT_NE(0u, string);
+
+    const std::size_t all = tape.strings().size();
+    const std::uint64_t inline_table_word = tape.tape()[inline_table];
+    const std::uint64_t header_word = tape.tape()[header];
+
+    EXPECT_EQ(tape.tape(), read(corrupted(tape.tape().size(), 0, all)).tape());
+
+    EXPECT_THROW(read(corrupted(0, tape.tape()[0] + 1, all)), loltoml::document_error_t);
+    EXPECT_THROW(read(corrupted(inline_table, inline_table_word + 1, all)), loltoml::document_error_t);
+    EXPECT_THROW(read(corrupted(inline_table, inline_table_word + (std::uint64_t(1) << 40), all)), loltoml::document_error_t);
+    EXPECT_THROW(read(corrupted(header, header_word - 1, all)), loltoml::document_error_t);
+    EXPECT_THROW(read(corrupted(header + 1, 1000, all)), loltoml::document_error_t);
+    EXPECT_THROW(read(corrupted(string, tape.tape()[string] + all, all)), loltoml::document_error_t);
+    EXPECT_THROW(read(corrupted(string, 0x7A00000000000000, all)), loltoml::document_error_t);
+    EXPECT_THROW(read(corrupted(tape.tape().size(), 0, all - 1)), loltoml::document_error_t);
+
+    // A corrupted size isn't trusted for the allocation.
+    std::string huge = corrupted(tape.tape().size(), 0, all);
+    huge[7] = '\x10';
+    EXPECT_THROW(read(huge), loltoml::stream_error_t);
+}
+
+
+TEST(TapeDocument, Stream) {
+    std::istringstream input(document);
+    loltoml::tape_document_t tape = loltoml::parse_tape(input);
+
+    EXPECT_EQ(parse_tape(document).tape(), tape.tape());
+}
+
+
+TEST(TapeDocument, StoppedInsideInlineTable) {
+    loltoml::parse_options_t options;
+    options.stop_after_keys = {{"server", "limits", "connections"}};
+    loltoml::tape_document_t tape = parse_tape(document, options);
+
+    std::vector<sax_event_t> events = replay(tape);
+    ASSERT_LE(3u, events.size());
+    EXPECT_EQ((sax_event_t{sax_event_t::finish_inline_table, 1}), events[events.size() - 2]);
+    EXPECT_EQ(tape.tape().size(), tape.next(0));
+}
@@ -0,0 +1,113 @@
+#include "common.hpp"
+
+#include "loltoml/detail/utf8.hpp"
+
+#include <cstdlib>
+
+
+namespace {
+    std::size_t error_offset(const std::string &document) {
+        events_aggregator_t handler;
+        loltoml::parse_options_t options;
+        options.validate_utf8 = true;
+
+        try {
+            loltoml::parse(document.data(), document.data() + document.size(), handler, options);
+        } catch (const loltoml::parser_error_t &e) {
+            EXPECT_TRUE(handler.events.empty());
+            return e.offset();
+        }
+
+        ADD_FAILURE() << "Document parsed successfully";
+        return 0;
+    }
+
+    std::size_t validate(const std::string &data) {
+        return static_cast<std::size_t>(
+            loltoml::detail::utf8::validate(data.data(), data.data() + data.size()) - data.data()
+        );
+    }
+
+    std::size_t scalar_validate(const std::string &data) {
+        return static_cast<std::size_t>(
+            loltoml::detail::utf8::scalar_validate(data.data(), data.data() + data.size()) - data.data()
+        );
+    }
+}
+
+
+TEST(Utf8, ValidDocument) {
+    std::string document =
+        "# Комментарий\n"
+        "\"ключ\" = \"значение \xe2\x82\xac \xf0\x9f\x98\x80\"\n"
+        "literal = '\xef\xbf\xbf'\n";
+
+    events_aggregator_t handler;
+    loltoml::parse_options_t options;
+    options.validate_utf8 = true;
+
+    loltoml::parse(document.data(), document.data() + document.size(), handler, options);
+
+    std::vector<sax_event_t> expected_events = {
+        {sax_event_t::start_document},
+        {sax_event_t::comment, " Комментарий"},
+        {sax_event_t::key, "ключ"},
+        {sax_event_t::string, "значение \xe2\x82\xac \xf0\x9f\x98\x80"},
+        {sax_event_t::key, "literal"},
+        {sax_event_t::string, "\xef\xbf\xbf"},
+        {sax_event_t::finish_document}
+    };
+
+    EXPECT_EQ(expected_events, handler.events);
+}
+
+TEST(Utf8, ValidationIsDisabledByDefault) {
+    std::string document = "key = \"\xff\"";
+    events_aggregator_t handler;
+
+    loltoml::parse(document.data(), document.data() + document.size(), handler, loltoml::parse_options_t());
+
+    EXPECT_EQ(sax_event_t(sax_event_t::string, "\xff"), handler.events.at(2));
+}
+
+TEST(Utf8, InvalidSequences) {
+    EXPECT_EQ(7u, error_offset("key = \"\x80\""));                   // Unexpected continuation byte.
+    EXPECT_EQ(7u, error_offset("key = \"\xc0\xaf\""));               // Overlong 2-byte encoding.
+    EXPECT_EQ(7u, error_offset("key = \"\xe0\x80\xaf\""));           // Overlong 3-byte encoding.
+    EXPECT_EQ(7u, error_offset("key = \"\xf0\x80\x80\xaf\""));       // Overlong 4-byte encoding.
+    EXPECT_EQ(7u, error_offset("key = \"\xed\xa0\x80\""));           // Surrogate.
+    EXPECT_EQ(7u, error_offset("key = \"\xf4\x90\x80\x80\""));       // Above U+10FFFF.
+    EXPECT_EQ(7u, error_offset("key = \"\xf8\x88\x80\x80\x80\""));   // 5-byte sequence.
+    EXPECT_EQ(7u, error_offset("key = \"\xe2\x82\""));               // Truncated sequence.
+    EXPECT_EQ(2u, error_offset("# \xe2\x82"));                       // Truncated at the end of the document.
+}
+
+TEST(Utf8, ErrorOffsetInLongDocument) {
+    std::string document = "# " + std::string(1000, 'a') + "\xd0\xb0" + std::string(100, 'b') + "\xd0 \n";
+    EXPECT_EQ(1104u, error_offset(document));
+}
+
+// The vectorized validator must agree with the scalar one everywhere, including block boundaries.
+TEST(Utf8, SameResultsAsScalarValidator) {
+    const char *sequences[] = {
+        "a", "\xd0\xb0", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xf4\x8f\xbf\xbf",
+        "\x80", "\xbf", "\xc0\x80", "\xc1\xbf", "\xe0\x9f\xbf", "\xed\xa0\x80", "\xf0\x8f\xbf\xbf",
+        "\xf4\x90\x80\x80", "\xf5\x80\x80\x80", "\xff", "\xd0", "\xe2\x82", "\xf0\x9f\x98"
+    };
+    const std::size_t sequences_count = sizeof(sequences) / sizeof(sequences[0]);
+
+    std::srand(42);
+
+    for (int i = 0; i < 20000; ++i) {
+        std::string data;
+        std::size_t length = static_cast<std::size_t>(std::rand() % 200);
+
+        while (data.size() < length) {
+            // Mostly valid characters, so that errors appear at various positions.
+            std::size_t index = static_cast<std::size_t>(std::rand() % (std::rand() % 50 == 0 ? sequences_count : 5));
+            data += sequences[index];
+        }
+
+        ASSERT_EQ(scalar_validate(data), validate(data)) << "iteration " << i;
+    }
+}
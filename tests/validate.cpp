@@ -0,0 +1,73 @@
+#include "common.hpp"
+
+#include "loltoml/validate.hpp"
+
+
+namespace {
+    loltoml::validation_result_t validate(const std::string &document) {
+        return loltoml::validate(document.data(), document.data() + document.size());
+    }
+
+    void expect_same_error_as_parse(const std::string &document) {
+        SCOPED_TRACE(document);
+
+        events_aggregator_t handler;
+
+        try {
+            loltoml::parse(document.data(), document.data() + document.size(), handler);
+            ADD_FAILURE() << "Document parsed successfully";
+        } catch (const loltoml::parser_error_t &e) {
+            loltoml::validation_result_t result = validate(document);
+
+            EXPECT_FALSE(result.valid);
+            EXPECT_EQ(e.offset(), result.error_offset);
+            EXPECT_EQ(std::string(e.message()), result.error_message);
+        }
+    }
+}
+
+
+TEST(Validate, ValidDocument) {
+    loltoml::validation_result_t result = validate(
+        "# comment\n"
+        "key = \"value\\t\\u00e9\"\n"
+        "\"\\t\" = 'escaped key'\n"
+        "[table . \"quoted key\"]\r\n"
+        "multiline = \"\"\"\none\\\n   two\\n\"\"\"\n"
+        "[[array.table]] # trailing comment\n"
+        "inline = { x = 1, y = 1.5e3, z = [true, false] }\n"
+        "symbol = key"
+    );
+
+    EXPECT_TRUE(result.valid);
+    EXPECT_EQ(0u, result.error_offset);
+    EXPECT_EQ("", result.error_message);
+}
+
+TEST(Validate, EmptyDocument) {
+    EXPECT_TRUE(loltoml::validate(static_cast<const char *>(nullptr), static_cast<const char *>(nullptr)).valid);
+}
+
+TEST(Validate, SameErrorsAsParse) {
+    expect_same_error_as_parse("key = \"unterminated");
+    expect_same_error_as_parse("\"\" = 1");
+    expect_same_error_as_parse("[table.\"\"]");
+    expect_same_error_as_parse("key = [1, \"two\"]");
+    expect_same_error_as_parse("key = 1.0e1000");
+    expect_same_error_as_parse("key = 9223372036854775808");
+    expect_same_error_as_parse("key = \"\\ud800\"");
+    expect_same_error_as_parse("[[table]\nkey = 1");
+    expect_same_error_as_parse("key = { a = 1 b = 2 }");
+}
+
+TEST(Validate, Utf8) {
+    std::string document = "key = \"\xc0\xaf\"";
+    loltoml::parse_options_t options;
+    options.validate_utf8 = true;
+
+    EXPECT_TRUE(validate(document).valid);
+
+    loltoml::validation_result_t result = loltoml::validate(document.data(), document.data() + document.size(), options);
+    EXPECT_FALSE(result.valid);
+    EXPECT_EQ(7u, result.error_offset);
+}